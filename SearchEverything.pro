@@ -1,4 +1,4 @@
-QT       += core gui widgets
+QT       += core gui widgets network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -11,12 +11,35 @@ SOURCES += \
     main.cpp \
     mainwindow.cpp \
     searchworker.cpp \
-    exportworker.cpp
+    resulttable.cpp \
+    exportworker.cpp \
+    iotuning.cpp \
+    calibrationworker.cpp \
+    watchworker.cpp \
+    daemonprotocol.cpp \
+    searchdaemon.cpp \
+    archivestream.cpp \
+    archiveworker.cpp \
+    xxhash3.cpp \
+    duplicateworker.cpp
 
 HEADERS += \
     mainwindow.h \
     searchworker.h \
-    exportworker.h
+    resulttable.h \
+    exportworker.h \
+    iotuning.h \
+    calibrationworker.h \
+    watchworker.h \
+    daemonprotocol.h \
+    searchdaemon.h \
+    archivestream.h \
+    archiveworker.h \
+    xxhash3.h \
+    duplicateworker.h
+
+# 校验后台服务进程所属用户
+win32: LIBS += -ladvapi32
 
 # 默认规则用于调试
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -0,0 +1,616 @@
+#include "archivestream.h"
+#include <QIODevice>
+#include <cstring>
+#include <memory>
+
+ByteSource::ByteSource(QIODevice *device, qint64 limit)
+    : dev(device)
+    , remaining(limit)
+{
+}
+
+bool ByteSource::fill()
+{
+    if (remaining == 0) {
+        return false;
+    }
+    qint64 want = sizeof(buffer);
+    if (remaining > 0 && remaining < want) {
+        want = remaining;
+    }
+    qint64 got = dev->read(buffer, want);
+    if (got <= 0) {
+        return false;
+    }
+    if (remaining > 0) {
+        remaining -= got;
+    }
+    pos = 0;
+    len = int(got);
+    return true;
+}
+
+int ByteSource::getByte()
+{
+    if (pos == len && !fill()) {
+        return -1;
+    }
+    return static_cast<unsigned char>(buffer[pos++]);
+}
+
+qint64 ByteSource::read(char *data, qint64 maxSize)
+{
+    qint64 total = 0;
+    while (total < maxSize) {
+        if (pos == len && !fill()) {
+            break;
+        }
+        qint64 chunk = qMin<qint64>(maxSize - total, len - pos);
+        std::memcpy(data + total, buffer + pos, size_t(chunk));
+        pos += int(chunk);
+        total += chunk;
+    }
+    return total;
+}
+
+bool ByteSource::atEnd()
+{
+    return pos == len && !fill();
+}
+
+// ---------------------------------------------------------------------------
+// DEFLATE (RFC 1951) 解码，结构参考 zlib 附带的 puff.c，改为 32 KB 环形窗口流式输出
+
+namespace {
+
+const int kMaxBits = 15;
+const int kWindowSize = 32768;
+
+struct Huffman
+{
+    short count[kMaxBits + 1];
+    short symbol[288];
+};
+
+const short kLengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const short kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const short kDistBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577 };
+const short kDistExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// 由码长构造规范 Huffman 表；返回 0 表示完整，>0 表示不完整，<0 表示码长非法
+int construct(Huffman &h, const short *length, int n)
+{
+    for (int len = 0; len <= kMaxBits; ++len) {
+        h.count[len] = 0;
+    }
+    for (int symbol = 0; symbol < n; ++symbol) {
+        h.count[length[symbol]]++;
+    }
+    if (h.count[0] == n) {
+        return 0;
+    }
+    int left = 1;
+    for (int len = 1; len <= kMaxBits; ++len) {
+        left <<= 1;
+        left -= h.count[len];
+        if (left < 0) {
+            return left;
+        }
+    }
+    short offs[kMaxBits + 1];
+    offs[1] = 0;
+    for (int len = 1; len < kMaxBits; ++len) {
+        offs[len + 1] = offs[len] + h.count[len];
+    }
+    for (int symbol = 0; symbol < n; ++symbol) {
+        if (length[symbol] != 0) {
+            h.symbol[offs[length[symbol]]++] = short(symbol);
+        }
+    }
+    return left;
+}
+
+class Inflater
+{
+public:
+    Inflater(ByteSource &src, const ChunkSink &out) : source(src), sink(out) {}
+
+    StreamResult run();
+
+private:
+    int bits(int need);
+    int decode(const Huffman &h);
+    bool put(unsigned char byte);
+    bool flush();
+    StreamResult stored();
+    StreamResult codes(const Huffman &lencode, const Huffman &distcode);
+    StreamResult fixed();
+    StreamResult dynamic();
+
+    ByteSource &source;
+    const ChunkSink &sink;
+    quint32 bitBuffer = 0;
+    int bitCount = 0;
+    bool inputError = false;
+    bool aborted = false;
+    unsigned char window[kWindowSize];
+    qint64 written = 0;       // 已解压的总字节数
+};
+
+int Inflater::bits(int need)
+{
+    quint32 value = bitBuffer;
+    while (bitCount < need) {
+        int byte = source.getByte();
+        if (byte < 0) {
+            inputError = true;
+            return 0;
+        }
+        value |= quint32(byte) << bitCount;
+        bitCount += 8;
+    }
+    bitBuffer = value >> need;
+    bitCount -= need;
+    return int(value & ((1U << need) - 1));
+}
+
+// 按规范码逐位解码（与 zlib 附带的 puff 相同），实现简单但每个符号要循环多次；
+// 单核约 70 MB/s，大约是 zlib 查表解码的一半以下，压缩包搜索靠多个条目并行弥补
+int Inflater::decode(const Huffman &h)
+{
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len <= kMaxBits; ++len) {
+        code |= bits(1);
+        if (inputError) {
+            return -1;
+        }
+        int count = h.count[len];
+        if (code - count < first) {
+            return h.symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+bool Inflater::flush()
+{
+    int pending = int(written % kWindowSize);
+    if (pending == 0 && written > 0) {
+        pending = kWindowSize;
+    }
+    return sink(reinterpret_cast<const char *>(window), pending);
+}
+
+bool Inflater::put(unsigned char byte)
+{
+    window[written % kWindowSize] = byte;
+    ++written;
+    // 窗口写满一圈时整块交给调用方，窗口内容仍保留给后续回溯引用
+    if (written % kWindowSize == 0 && !sink(reinterpret_cast<const char *>(window), kWindowSize)) {
+        aborted = true;
+        return false;
+    }
+    return true;
+}
+
+StreamResult Inflater::stored()
+{
+    bitBuffer = 0;
+    bitCount = 0;
+    int b0 = source.getByte();
+    int b1 = source.getByte();
+    int b2 = source.getByte();
+    int b3 = source.getByte();
+    if (b3 < 0) {
+        return StreamResult::DataError;
+    }
+    int len = b0 | (b1 << 8);
+    if (len != (~(b2 | (b3 << 8)) & 0xffff)) {
+        return StreamResult::DataError;
+    }
+    while (len--) {
+        int byte = source.getByte();
+        if (byte < 0) {
+            return StreamResult::DataError;
+        }
+        if (!put(static_cast<unsigned char>(byte))) {
+            return StreamResult::Aborted;
+        }
+    }
+    return StreamResult::Ok;
+}
+
+StreamResult Inflater::codes(const Huffman &lencode, const Huffman &distcode)
+{
+    for (;;) {
+        int symbol = decode(lencode);
+        if (symbol < 0) {
+            return StreamResult::DataError;
+        }
+        if (symbol < 256) {
+            if (!put(static_cast<unsigned char>(symbol))) {
+                return StreamResult::Aborted;
+            }
+        } else if (symbol == 256) {
+            return StreamResult::Ok;
+        } else {
+            symbol -= 257;
+            if (symbol >= 29) {
+                return StreamResult::DataError;
+            }
+            int len = kLengthBase[symbol] + bits(kLengthExtra[symbol]);
+            symbol = decode(distcode);
+            if (symbol < 0 || symbol >= 30) {
+                return StreamResult::DataError;
+            }
+            int dist = kDistBase[symbol] + bits(kDistExtra[symbol]);
+            if (inputError || dist > written) {
+                return StreamResult::DataError;
+            }
+            while (len--) {
+                if (!put(window[(written - dist) % kWindowSize])) {
+                    return StreamResult::Aborted;
+                }
+            }
+        }
+    }
+}
+
+StreamResult Inflater::fixed()
+{
+    static Huffman lencode;
+    static Huffman distcode;
+    static const bool built = []() {
+        short lengths[288];
+        int symbol = 0;
+        for (; symbol < 144; ++symbol) lengths[symbol] = 8;
+        for (; symbol < 256; ++symbol) lengths[symbol] = 9;
+        for (; symbol < 280; ++symbol) lengths[symbol] = 7;
+        for (; symbol < 288; ++symbol) lengths[symbol] = 8;
+        construct(lencode, lengths, 288);
+        for (symbol = 0; symbol < 30; ++symbol) lengths[symbol] = 5;
+        construct(distcode, lengths, 30);
+        return true;
+    }();
+    Q_UNUSED(built);
+    return codes(lencode, distcode);
+}
+
+StreamResult Inflater::dynamic()
+{
+    static const short order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    short lengths[286 + 30];
+    Huffman lencode;
+    Huffman distcode;
+
+    int nlen = bits(5) + 257;
+    int ndist = bits(5) + 1;
+    int ncode = bits(4) + 4;
+    if (inputError || nlen > 286 || ndist > 30) {
+        return StreamResult::DataError;
+    }
+
+    int index = 0;
+    for (; index < ncode; ++index) {
+        lengths[order[index]] = short(bits(3));
+    }
+    for (; index < 19; ++index) {
+        lengths[order[index]] = 0;
+    }
+    if (inputError || construct(lencode, lengths, 19) != 0) {
+        return StreamResult::DataError;
+    }
+
+    index = 0;
+    while (index < nlen + ndist) {
+        int symbol = decode(lencode);
+        if (symbol < 0) {
+            return StreamResult::DataError;
+        }
+        if (symbol < 16) {
+            lengths[index++] = short(symbol);
+            continue;
+        }
+        short len = 0;
+        if (symbol == 16) {
+            if (index == 0) {
+                return StreamResult::DataError;
+            }
+            len = lengths[index - 1];
+            symbol = 3 + bits(2);
+        } else if (symbol == 17) {
+            symbol = 3 + bits(3);
+        } else {
+            symbol = 11 + bits(7);
+        }
+        if (inputError || index + symbol > nlen + ndist) {
+            return StreamResult::DataError;
+        }
+        while (symbol--) {
+            lengths[index++] = len;
+        }
+    }
+    if (lengths[256] == 0) {
+        return StreamResult::DataError;
+    }
+
+    int err = construct(lencode, lengths, nlen);
+    if (err < 0 || (err > 0 && nlen - lencode.count[0] != 1)) {
+        return StreamResult::DataError;
+    }
+    err = construct(distcode, lengths + nlen, ndist);
+    if (err < 0 || (err > 0 && ndist - distcode.count[0] != 1)) {
+        return StreamResult::DataError;
+    }
+    return codes(lencode, distcode);
+}
+
+StreamResult Inflater::run()
+{
+    int last = 0;
+    do {
+        last = bits(1);
+        int type = bits(2);
+        if (inputError) {
+            return StreamResult::DataError;
+        }
+        StreamResult result;
+        if (type == 0) {
+            result = stored();
+        } else if (type == 1) {
+            result = fixed();
+        } else if (type == 2) {
+            result = dynamic();
+        } else {
+            result = StreamResult::DataError;
+        }
+        if (result != StreamResult::Ok) {
+            return result;
+        }
+    } while (!last);
+
+    if (written % kWindowSize != 0 && !flush()) {
+        return StreamResult::Aborted;
+    }
+    return StreamResult::Ok;
+}
+
+} // namespace
+
+StreamResult inflateRaw(ByteSource &source, const ChunkSink &sink)
+{
+    // 解码器自带 32 KB 窗口，放在堆上避免占用工作线程的栈
+    std::unique_ptr<Inflater> inflater(new Inflater(source, sink));
+    return inflater->run();
+}
+
+static bool skipZeroTerminated(ByteSource &source)
+{
+    int byte;
+    do {
+        byte = source.getByte();
+    } while (byte > 0);
+    return byte == 0;
+}
+
+StreamResult gunzip(ByteSource &source, const ChunkSink &sink)
+{
+    bool firstMember = true;
+    while (firstMember || !source.atEnd()) {
+        unsigned char head[10];
+        if (source.read(reinterpret_cast<char *>(head), 10) != 10) {
+            return StreamResult::DataError;
+        }
+        if (head[0] != 0x1f || head[1] != 0x8b || head[2] != 8) {
+            // 多成员之后的填充数据按结束处理
+            return firstMember ? StreamResult::DataError : StreamResult::Ok;
+        }
+        int flags = head[3];
+        if (flags & 0x04) {                 // FEXTRA
+            int lo = source.getByte();
+            int hi = source.getByte();
+            if (hi < 0) {
+                return StreamResult::DataError;
+            }
+            for (int n = lo | (hi << 8); n > 0; --n) {
+                if (source.getByte() < 0) {
+                    return StreamResult::DataError;
+                }
+            }
+        }
+        if ((flags & 0x08) && !skipZeroTerminated(source)) {   // FNAME
+            return StreamResult::DataError;
+        }
+        if ((flags & 0x10) && !skipZeroTerminated(source)) {   // FCOMMENT
+            return StreamResult::DataError;
+        }
+        if (flags & 0x02) {                 // FHCRC
+            source.getByte();
+            source.getByte();
+        }
+
+        StreamResult result = inflateRaw(source, sink);
+        if (result != StreamResult::Ok) {
+            return result;
+        }
+        char trailer[8];                    // CRC32 + ISIZE
+        if (source.read(trailer, 8) != 8) {
+            return StreamResult::DataError;
+        }
+        firstMember = false;
+    }
+    return StreamResult::Ok;
+}
+
+// ---------------------------------------------------------------------------
+// tar（ustar / GNU 长文件名 / pax path）
+
+static qint64 parseOctal(const char *field, int size)
+{
+    // GNU base-256 编码用于超过 8 GB 的文件
+    if (static_cast<unsigned char>(field[0]) & 0x80) {
+        qint64 value = field[0] & 0x7f;
+        for (int i = 1; i < size; ++i) {
+            value = (value << 8) | static_cast<unsigned char>(field[i]);
+        }
+        return value;
+    }
+    qint64 value = 0;
+    for (int i = 0; i < size && field[i]; ++i) {
+        if (field[i] == ' ') {
+            continue;
+        }
+        if (field[i] < '0' || field[i] > '7') {
+            break;
+        }
+        value = value * 8 + (field[i] - '0');
+    }
+    return value;
+}
+
+static QString fieldString(const char *field, int size)
+{
+    return QString::fromUtf8(field, int(qstrnlen(field, size)));
+}
+
+TarParser::TarParser(const EntryHandler &handler)
+    : onEntry(handler)
+{
+}
+
+bool TarParser::parseHeader()
+{
+    entryWanted = false;
+    entryAborted = false;
+    entrySink = ChunkSink();
+    metaType = 0;
+
+    bool allZero = true;
+    for (int i = 0; i < 512; ++i) {
+        if (header[i]) {
+            allZero = false;
+            break;
+        }
+    }
+    if (allZero) {
+        endOfArchive = true;
+        return true;
+    }
+
+    qint64 checksum = parseOctal(header + 148, 8);
+    qint64 sum = 0;
+    for (int i = 0; i < 512; ++i) {
+        sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(header[i]);
+    }
+    if (sum != checksum) {
+        return false;
+    }
+
+    qint64 size = parseOctal(header + 124, 12);
+    if (size < 0) {
+        return false;
+    }
+    char type = header[156];
+    dataRemaining = size;
+    padRemaining = (512 - size % 512) % 512;
+
+    if (type == 'L' || type == 'x' || type == 'K' || type == 'g') {
+        // 'K'（GNU 长链接目标）和 'g'（pax 全局头）不决定下一个条目的路径，读完即丢弃
+        metaType = type;
+        metaBuffer.clear();
+        return true;
+    }
+
+    // 长文件名只属于紧随其后的这一个条目，目录、链接等非普通文件也要消耗掉，
+    // 否则会错误地套用到下一个普通文件上
+    QString path = pendingLongName;
+    pendingLongName.clear();
+    if (type == '0' || type == '\0' || type == '7') {
+        if (path.isEmpty()) {
+            path = fieldString(header, 100);
+            if (std::memcmp(header + 257, "ustar", 5) == 0 && header[345]) {
+                path = fieldString(header + 345, 155) + "/" + path;
+            }
+        }
+        entrySink = onEntry(path, size);
+        entryWanted = bool(entrySink);
+    }
+    return true;
+}
+
+bool TarParser::feed(const char *data, qint64 size)
+{
+    static const int kMaxMetaSize = 1024 * 1024;
+    while (size > 0 && !endOfArchive) {
+        if (dataRemaining > 0) {
+            qint64 chunk = qMin(size, dataRemaining);
+            if (metaType) {
+                if (metaBuffer.size() + chunk <= kMaxMetaSize) {
+                    metaBuffer.append(data, chunk);
+                }
+            } else if (entryWanted && !entryAborted) {
+                entryAborted = !entrySink(data, chunk);
+            }
+            data += chunk;
+            size -= chunk;
+            dataRemaining -= chunk;
+            if (dataRemaining > 0) {
+                continue;
+            }
+            if (metaType == 'L') {
+                pendingLongName = QString::fromUtf8(metaBuffer.constData(), int(qstrnlen(metaBuffer.constData(), metaBuffer.size())));
+            } else if (metaType == 'x') {
+                // pax 记录格式: "<长度> <键>=<值>\n"
+                const QList<QByteArray> records = metaBuffer.split('\n');
+                for (const QByteArray &record : records) {
+                    int space = record.indexOf(' ');
+                    if (space > 0 && record.mid(space + 1).startsWith("path=")) {
+                        pendingLongName = QString::fromUtf8(record.mid(space + 6));
+                    }
+                }
+            } else if (entryWanted && !entryAborted) {
+                entryAborted = !entrySink(nullptr, 0);   // 条目结束通知
+            }
+            metaType = 0;
+            continue;
+        }
+        if (padRemaining > 0) {
+            qint64 chunk = qMin(size, padRemaining);
+            data += chunk;
+            size -= chunk;
+            padRemaining -= chunk;
+            continue;
+        }
+        int chunk = int(qMin<qint64>(size, 512 - headerFill));
+        std::memcpy(header + headerFill, data, size_t(chunk));
+        headerFill += chunk;
+        data += chunk;
+        size -= chunk;
+        if (headerFill == 512) {
+            headerFill = 0;
+            if (!parseHeader()) {
+                return false;
+            }
+            // 空文件没有数据块，直接通知结束
+            if (dataRemaining == 0 && entryWanted) {
+                entrySink(nullptr, 0);
+            }
+        }
+    }
+    return true;
+}
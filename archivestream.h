@@ -0,0 +1,76 @@
+#ifndef ARCHIVESTREAM_H
+#define ARCHIVESTREAM_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QByteArray>
+#include <functional>
+
+class QIODevice;
+
+// 解压输出回调，返回 false 表示调用方不再需要后续数据（提前终止）
+using ChunkSink = std::function<bool(const char *data, qint64 size)>;
+
+// 带固定大小缓冲的顺序读取，可限制最多读取的字节数（用于 zip 中单个条目）
+class ByteSource
+{
+public:
+    explicit ByteSource(QIODevice *device, qint64 limit = -1);
+
+    int getByte();                          // 数据结束时返回 -1
+    qint64 read(char *data, qint64 maxSize);
+    bool atEnd();
+
+private:
+    bool fill();
+
+    QIODevice *dev;
+    qint64 remaining;
+    char buffer[64 * 1024];
+    int pos = 0;
+    int len = 0;
+};
+
+enum class StreamResult {
+    Ok,
+    DataError,
+    Aborted
+};
+
+// 流式解压 raw DEFLATE（zip 条目），只保留 32 KB 窗口
+StreamResult inflateRaw(ByteSource &source, const ChunkSink &sink);
+
+// 流式解压 gzip（支持多成员），不校验 CRC
+StreamResult gunzip(ByteSource &source, const ChunkSink &sink);
+
+// tar 流解析：按块推入数据，逐个条目回调
+class TarParser
+{
+public:
+    // 返回该条目的数据回调；返回空函数表示跳过该条目
+    // 条目数据全部送出后，会再以 (nullptr, 0) 调用一次表示条目结束
+    using EntryHandler = std::function<ChunkSink(const QString &path, qint64 size)>;
+
+    explicit TarParser(const EntryHandler &handler);
+
+    bool feed(const char *data, qint64 size);   // 格式错误或被中止时返回 false
+    bool finished() const { return endOfArchive; }
+
+private:
+    bool parseHeader();
+
+    EntryHandler onEntry;
+    char header[512];
+    int headerFill = 0;
+    qint64 dataRemaining = 0;
+    qint64 padRemaining = 0;
+    ChunkSink entrySink;
+    bool entryWanted = false;
+    bool entryAborted = false;
+    int metaType = 0;                 // 'L' (GNU 长文件名) 或 'x' (pax) 正在读取元数据
+    QByteArray metaBuffer;
+    QString pendingLongName;
+    bool endOfArchive = false;
+};
+
+#endif // ARCHIVESTREAM_H
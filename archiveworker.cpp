@@ -0,0 +1,583 @@
+#include "archiveworker.h"
+#include "archivestream.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include <QThread>
+#include <QtEndian>
+#include <algorithm>
+#include <memory>
+
+static const int kChunkSize = 64 * 1024;
+static const int kMaxLineSize = 1024 * 1024;           // 正则按行匹配，超长行截断处理
+static const int kZipBatchEntries = 64;
+static const qint64 kZipBatchBytes = 16 * 1024 * 1024;
+
+namespace {
+
+quint16 le16(const char *p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+
+quint32 le32(const char *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+quint64 le64(const char *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+// 对单个条目的解压数据做流式匹配，只保留跨块所需的少量尾部数据
+class ContentMatcher
+{
+public:
+    ContentMatcher(const QByteArray &fixedNeedle, const QRegularExpression &re, bool useRegex)
+        : needle(fixedNeedle)
+        , regex(re)
+        , regexMode(useRegex)
+    {
+    }
+
+    // 返回 true 表示本次数据使首次命中
+    bool feed(const char *data, qint64 size)
+    {
+        if (hit) {
+            return false;
+        }
+        hit = regexMode ? feedRegex(data, size) : feedFixed(data, size);
+        return hit;
+    }
+
+    // 数据结束时检查最后一行（不以换行结尾）
+    bool finish()
+    {
+        if (hit || !regexMode || line.isEmpty()) {
+            return false;
+        }
+        hit = testLine();
+        return hit;
+    }
+
+private:
+    bool feedFixed(const char *data, qint64 size)
+    {
+        const qint64 n = needle.size();
+        if (n == 0) {
+            return true;
+        }
+        // 先检查跨越上一块末尾和本块开头的位置
+        if (!tail.isEmpty()) {
+            QByteArray boundary = tail + QByteArray(data, int(qMin(size, n - 1)));
+            if (boundary.contains(needle)) {
+                return true;
+            }
+        }
+        const char *end = data + size;
+        if (std::search(data, end, needle.constData(), needle.constData() + n) != end) {
+            return true;
+        }
+        if (size >= n - 1) {
+            tail = QByteArray(end - (n - 1), int(n - 1));
+        } else {
+            tail = (tail + QByteArray(data, int(size))).right(int(n - 1));
+        }
+        return false;
+    }
+
+    bool feedRegex(const char *data, qint64 size)
+    {
+        const char *end = data + size;
+        while (data < end) {
+            const char *newline = std::find(data, end, '\n');
+            line.append(data, int(newline - data));
+            if (newline == end) {
+                if (line.size() > kMaxLineSize && testLine()) {
+                    return true;
+                }
+                break;
+            }
+            if (testLine()) {
+                return true;
+            }
+            data = newline + 1;
+        }
+        return false;
+    }
+
+    bool testLine()
+    {
+        bool matched = regex.match(QString::fromUtf8(line)).hasMatch();
+        line.clear();
+        return matched;
+    }
+
+    QByteArray needle;
+    QRegularExpression regex;
+    bool regexMode;
+    QByteArray tail;
+    QByteArray line;
+    bool hit = false;
+};
+
+} // namespace
+
+ArchiveWorker::ArchiveWorker(QObject *parent) : QObject(parent)
+{
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+    taskSlots.release(pool.maxThreadCount() * 2);
+}
+
+void ArchiveWorker::stop()
+{
+    cancelled = true;
+}
+
+ArchiveWorker::ArchiveType ArchiveWorker::archiveType(const QString &fileName)
+{
+    const QString name = fileName.toLower();
+    if (name.endsWith(".tar.gz") || name.endsWith(".tgz")) {
+        return ArchiveType::TarGz;
+    }
+    if (name.endsWith(".tar.zst") || name.endsWith(".tzst")) {
+        return ArchiveType::TarZst;
+    }
+    if (name.endsWith(".tar")) {
+        return ArchiveType::Tar;
+    }
+    if (name.endsWith(".zip")) {
+        return ArchiveType::Zip;
+    }
+    if (name.endsWith(".gz")) {
+        return ArchiveType::Gz;
+    }
+    if (name.endsWith(".zst")) {
+        return ArchiveType::Zst;
+    }
+    return ArchiveType::None;
+}
+
+void ArchiveWorker::start(const QString &rootPath, const QString &searchText, bool fixedString, const QStringList &filePatterns)
+{
+    cancelled = false;
+    hits = 0;
+    zstdMissingReported = false;
+    nameOnly = searchText.isEmpty();
+    fixed = fixedString;
+    needle = searchText.toUtf8();
+    regex = QRegularExpression(fixedString || nameOnly ? QString() : searchText);
+    if (!fixed && !nameOnly && !regex.isValid()) {
+        emit warning("正则表达式无效: " + regex.errorString());
+        emit finished(2, QProcess::NormalExit);
+        return;
+    }
+    patterns.clear();
+    excludePatterns.clear();
+    for (const QString &pat : filePatterns) {
+        QString trimmed = pat.trimmed();
+        bool exclude = trimmed.startsWith('!');
+        if (exclude) {
+            trimmed = trimmed.mid(1);
+        }
+        if (trimmed.isEmpty()) {
+            continue;
+        }
+        QRegularExpression re(QRegularExpression::wildcardToRegularExpression(trimmed));
+        (exclude ? excludePatterns : patterns) << re;
+    }
+
+    zstdPath = QStandardPaths::findExecutable("zstd");
+    if (zstdPath.isEmpty()) {
+        zstdPath = QStandardPaths::findExecutable("zstd", QStringList() << QCoreApplication::applicationDirPath());
+    }
+
+    QDirIterator it(rootPath, QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
+    while (it.hasNext() && !cancelled) {
+        const QString archive = it.next();
+        if (archive.contains("/System Volume Information/") || archive.contains("/$RECYCLE.BIN/")) {
+            continue;
+        }
+        const QString fileName = it.fileName();
+        ArchiveType type = archiveType(fileName);
+        if (type == ArchiveType::None) {
+            continue;
+        }
+        // 普通搜索中被 ! 条件排除的压缩包本身，这里同样不搜索
+        if (isExcluded(fileName, QDir(rootPath).relativeFilePath(archive))) {
+            continue;
+        }
+        // 过滤条件直接匹配压缩包名（如 *.zip）时，包内所有条目都参与搜索
+        bool archiveMatched = false;
+        for (const QRegularExpression &re : std::as_const(patterns)) {
+            if (re.match(fileName).hasMatch()) {
+                archiveMatched = true;
+                break;
+            }
+        }
+
+        if (type == ArchiveType::Zip) {
+            scanZip(archive, archiveMatched);
+        } else if (type == ArchiveType::Gz || type == ArchiveType::Zst) {
+            submit([=]() { searchSingle(archive, type, archiveMatched); });
+        } else {
+            submit([=]() { searchTar(archive, type, archiveMatched); });
+        }
+    }
+    pool.waitForDone();
+    emit finished(hits > 0 ? 0 : 1, QProcess::NormalExit);
+}
+
+void ArchiveWorker::submit(const std::function<void()> &task)
+{
+    // 队列满时阻塞目录遍历，避免任务堆积占用内存
+    taskSlots.acquire();
+    pool.start([this, task]() {
+        if (!cancelled) {
+            task();
+        }
+        taskSlots.release();
+    });
+}
+
+bool ArchiveWorker::isExcluded(const QString &name, const QString &path) const
+{
+    for (const QRegularExpression &re : excludePatterns) {
+        if (re.match(name).hasMatch() || re.match(path).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ArchiveWorker::nameMatches(const QString &innerPath, bool archiveMatched) const
+{
+    const QString name = innerPath.section('/', -1);
+    if (isExcluded(name, innerPath)) {
+        return false;
+    }
+    if (archiveMatched || patterns.isEmpty()) {
+        return true;
+    }
+    for (const QRegularExpression &re : patterns) {
+        if (re.match(name).hasMatch() || re.match(innerPath).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ArchiveWorker::report(const QString &archive, const QString &innerPath)
+{
+    ++hits;
+    const QString name = innerPath.section('/', -1);
+    const QString innerDir = innerPath.section('/', 0, -2);
+    emit resultFound(name, archive + "!/" + innerDir);
+}
+
+void ArchiveWorker::scanZip(const QString &archive, bool archiveMatched)
+{
+    QFile file(archive);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < 22) {
+        return;
+    }
+
+    // 目录结束记录位于文件末尾，后面最多跟 64 KB 注释
+    const qint64 size = file.size();
+    const qint64 tailSize = qMin<qint64>(size, 22 + 65535);
+    file.seek(size - tailSize);
+    const QByteArray tail = file.read(tailSize);
+    int eocd = -1;
+    for (int i = tail.size() - 22; i >= 0; --i) {
+        if (le32(tail.constData() + i) == 0x06054b50) {
+            eocd = i;
+            break;
+        }
+    }
+    if (eocd < 0) {
+        emit warning("无法识别的 zip 文件: " + archive);
+        return;
+    }
+
+    const char *record = tail.constData() + eocd;
+    qint64 cdSize = le32(record + 12);
+    qint64 cdOffset = le32(record + 16);
+    if ((cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF || le16(record + 10) == 0xFFFF)
+        && eocd >= 20 && le32(record - 20) == 0x07064b50) {
+        // ZIP64
+        file.seek(qint64(le64(record - 20 + 8)));
+        const QByteArray zip64 = file.read(56);
+        if (zip64.size() == 56 && le32(zip64.constData()) == 0x06064b50) {
+            cdSize = qint64(le64(zip64.constData() + 40));
+            cdOffset = qint64(le64(zip64.constData() + 48));
+        }
+    }
+    if (!file.seek(cdOffset)) {
+        return;
+    }
+
+    // 逐条读取中央目录并分批派发，条目数再多也只在内存中保留一批
+    ByteSource source(&file, cdSize);
+    QList<ZipEntry> batch;
+    qint64 batchBytes = 0;
+    char header[46];
+    while (!cancelled && source.read(header, 46) == 46 && le32(header) == 0x02014b50) {
+        const quint16 flags = le16(header + 8);
+        ZipEntry entry;
+        entry.method = le16(header + 10);
+        entry.compressedSize = le32(header + 20);
+        qint64 uncompressedSize = le32(header + 24);
+        const int nameLen = le16(header + 28);
+        const int extraLen = le16(header + 30);
+        const int commentLen = le16(header + 32);
+        entry.localHeaderOffset = le32(header + 42);
+
+        QByteArray name(nameLen, Qt::Uninitialized);
+        QByteArray extra(extraLen, Qt::Uninitialized);
+        QByteArray comment(commentLen, Qt::Uninitialized);
+        if (source.read(name.data(), nameLen) != nameLen
+            || source.read(extra.data(), extraLen) != extraLen
+            || source.read(comment.data(), commentLen) != commentLen) {
+            break;
+        }
+
+        // ZIP64 扩展字段：按顺序只包含值为 0xFFFFFFFF 的字段
+        for (int pos = 0; pos + 4 <= extra.size();) {
+            const quint16 id = le16(extra.constData() + pos);
+            const quint16 len = le16(extra.constData() + pos + 2);
+            if (id == 0x0001) {
+                int p = pos + 4;
+                const int end = qMin(extra.size(), p + len);
+                if (uncompressedSize == 0xFFFFFFFF && p + 8 <= end) {
+                    p += 8;
+                }
+                if (entry.compressedSize == 0xFFFFFFFF && p + 8 <= end) {
+                    entry.compressedSize = qint64(le64(extra.constData() + p));
+                    p += 8;
+                }
+                if (entry.localHeaderOffset == 0xFFFFFFFF && p + 8 <= end) {
+                    entry.localHeaderOffset = qint64(le64(extra.constData() + p));
+                }
+                break;
+            }
+            pos += 4 + len;
+        }
+
+        entry.name = (flags & 0x0800) ? QString::fromUtf8(name) : QString::fromLocal8Bit(name);
+        if (entry.name.endsWith('/') || (flags & 0x0001)) {
+            continue; // 目录或加密条目
+        }
+        if (!nameMatches(entry.name, archiveMatched)) {
+            continue;
+        }
+        if (nameOnly) {
+            report(archive, entry.name);
+            continue;
+        }
+
+        batch << entry;
+        batchBytes += entry.compressedSize;
+        if (batch.size() >= kZipBatchEntries || batchBytes >= kZipBatchBytes) {
+            submit([this, archive, batch]() { searchZipEntries(archive, batch); });
+            batch.clear();
+            batchBytes = 0;
+        }
+    }
+    if (!batch.isEmpty()) {
+        submit([this, archive, batch]() { searchZipEntries(archive, batch); });
+    }
+}
+
+void ArchiveWorker::searchZipEntries(const QString &archive, const QList<ZipEntry> &entries)
+{
+    QFile file(archive);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    for (const ZipEntry &entry : entries) {
+        if (cancelled) {
+            return;
+        }
+        // 仅支持 stored(0) 和 deflate(8)
+        if (entry.method != 0 && entry.method != 8) {
+            continue;
+        }
+        char local[30];
+        if (!file.seek(entry.localHeaderOffset) || file.read(local, 30) != 30 || le32(local) != 0x04034b50) {
+            continue;
+        }
+        if (!file.seek(entry.localHeaderOffset + 30 + le16(local + 26) + le16(local + 28))) {
+            continue;
+        }
+
+        ContentMatcher matcher(needle, regex, !fixed);
+        bool matched = false;
+        auto sink = [&](const char *data, qint64 size) {
+            if (cancelled) {
+                return false;
+            }
+            matched = matcher.feed(data, size);
+            return !matched;
+        };
+
+        std::unique_ptr<ByteSource> source(new ByteSource(&file, entry.compressedSize));
+        StreamResult result = StreamResult::Ok;
+        if (entry.method == 8) {
+            result = inflateRaw(*source, sink);
+        } else {
+            QByteArray chunk(kChunkSize, Qt::Uninitialized);
+            qint64 n;
+            while ((n = source->read(chunk.data(), kChunkSize)) > 0 && sink(chunk.constData(), n)) {
+            }
+        }
+        if (result == StreamResult::DataError) {
+            emit warning(QString("zip 条目解压失败: %1!/%2").arg(archive, entry.name));
+        }
+        if (matched || (!cancelled && matcher.finish())) {
+            report(archive, entry.name);
+        }
+    }
+}
+
+void ArchiveWorker::searchTar(const QString &archive, ArchiveType type, bool archiveMatched)
+{
+    QFile file(archive);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    TarParser tar([&](const QString &path, qint64) -> ChunkSink {
+        if (cancelled || !nameMatches(path, archiveMatched)) {
+            return ChunkSink();
+        }
+        if (nameOnly) {
+            report(archive, path);
+            return ChunkSink();
+        }
+        auto matcher = std::make_shared<ContentMatcher>(needle, regex, !fixed);
+        return [this, archive, path, matcher](const char *data, qint64 size) {
+            if (!data) {
+                if (matcher->finish()) {
+                    report(archive, path);
+                }
+                return true;
+            }
+            if (matcher->feed(data, size)) {
+                report(archive, path);
+                return false;
+            }
+            return true;
+        };
+    });
+
+    bool formatError = false;
+    auto sink = [&](const char *data, qint64 size) {
+        if (cancelled) {
+            return false;
+        }
+        if (!tar.feed(data, size)) {
+            formatError = true;
+            return false;
+        }
+        return !tar.finished();
+    };
+
+    StreamResult result = StreamResult::Ok;
+    if (type == ArchiveType::Tar) {
+        QByteArray chunk(kChunkSize, Qt::Uninitialized);
+        qint64 n;
+        while ((n = file.read(chunk.data(), kChunkSize)) > 0 && sink(chunk.constData(), n)) {
+        }
+    } else if (type == ArchiveType::TarGz) {
+        std::unique_ptr<ByteSource> source(new ByteSource(&file));
+        result = gunzip(*source, sink);
+    } else {
+        result = readZstd(archive, sink) ? StreamResult::Ok : StreamResult::DataError;
+    }
+    if (formatError || result == StreamResult::DataError) {
+        emit warning("压缩包损坏或格式不支持: " + archive);
+    }
+}
+
+void ArchiveWorker::searchSingle(const QString &archive, ArchiveType type, bool archiveMatched)
+{
+    QFileInfo info(archive);
+    const QString innerName = info.completeBaseName();   // app.log.gz -> app.log
+    if (!nameMatches(innerName, archiveMatched)) {
+        return;
+    }
+    if (nameOnly) {
+        report(archive, innerName);
+        return;
+    }
+
+    ContentMatcher matcher(needle, regex, !fixed);
+    bool matched = false;
+    auto sink = [&](const char *data, qint64 size) {
+        if (cancelled) {
+            return false;
+        }
+        matched = matcher.feed(data, size);
+        return !matched;
+    };
+
+    StreamResult result = StreamResult::Ok;
+    if (type == ArchiveType::Gz) {
+        QFile file(archive);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        std::unique_ptr<ByteSource> source(new ByteSource(&file));
+        result = gunzip(*source, sink);
+    } else if (!readZstd(archive, sink)) {
+        result = StreamResult::DataError;
+    }
+    if (result == StreamResult::DataError && !matched) {
+        emit warning("压缩包损坏或格式不支持: " + archive);
+    }
+    if (matched || (!cancelled && matcher.finish())) {
+        report(archive, innerName);
+    }
+}
+
+bool ArchiveWorker::readZstd(const QString &archive, const std::function<bool(const char *, qint64)> &sink)
+{
+    // Qt 不带 zstd 解码器，借助 zstd 命令行以管道流式解压，数据不落盘
+    if (zstdPath.isEmpty()) {
+        if (!zstdMissingReported.exchange(true)) {
+            emit warning("未找到 zstd 可执行文件，已跳过 .zst 压缩包");
+        }
+        return true;
+    }
+
+    QProcess process;
+    process.start(zstdPath, QStringList() << "-dc" << "--" << archive);
+    if (!process.waitForStarted(5000)) {
+        return false;
+    }
+    QByteArray chunk(kChunkSize, Qt::Uninitialized);
+    bool stopped = false;
+    for (;;) {
+        if (process.bytesAvailable() == 0) {
+            if (process.state() == QProcess::NotRunning) {
+                break;
+            }
+            process.waitForReadyRead(100);
+            continue;
+        }
+        qint64 n = process.read(chunk.data(), kChunkSize);
+        if (n > 0 && !sink(chunk.constData(), n)) {
+            stopped = true;
+            break;
+        }
+    }
+    if (process.state() != QProcess::NotRunning) {
+        process.kill();
+        process.waitForFinished();
+    }
+    return stopped || (process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0);
+}
@@ -0,0 +1,73 @@
+#ifndef ARCHIVEWORKER_H
+#define ARCHIVEWORKER_H
+
+#include <QObject>
+#include <QProcess>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QRegularExpression>
+#include <QList>
+#include <atomic>
+#include <functional>
+
+// 压缩包内容搜索：流式读取 zip/tar/gz/zst，不解压到磁盘，命中结果以 "压缩包!/内部路径" 表示
+class ArchiveWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ArchiveWorker(QObject *parent = nullptr);
+
+public slots:
+    void start(const QString &rootPath, const QString &searchText, bool fixedString, const QStringList &filePatterns);
+    void stop();
+
+signals:
+    void resultFound(const QString &name, const QString &path);
+    void finished(int exitCode, QProcess::ExitStatus exitStatus);
+    void warning(const QString &message);
+
+private:
+    enum class ArchiveType {
+        None,
+        Zip,
+        Tar,
+        TarGz,
+        TarZst,
+        Gz,
+        Zst
+    };
+
+    struct ZipEntry {
+        QString name;
+        quint16 method = 0;
+        qint64 compressedSize = 0;
+        qint64 localHeaderOffset = 0;
+    };
+
+    static ArchiveType archiveType(const QString &fileName);
+
+    void submit(const std::function<void()> &task);
+    void scanZip(const QString &archive, bool archiveMatched);
+    void searchZipEntries(const QString &archive, const QList<ZipEntry> &entries);
+    void searchTar(const QString &archive, ArchiveType type, bool archiveMatched);
+    void searchSingle(const QString &archive, ArchiveType type, bool archiveMatched);
+    bool readZstd(const QString &archive, const std::function<bool(const char *, qint64)> &sink);
+    bool nameMatches(const QString &innerPath, bool archiveMatched) const;
+    bool isExcluded(const QString &name, const QString &path) const;
+    void report(const QString &archive, const QString &innerPath);
+
+    QThreadPool pool;
+    QSemaphore taskSlots;            // 限制排队任务数，保证内存有上限
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> hits{0};
+    std::atomic<bool> zstdMissingReported{false};
+    QString zstdPath;
+    QByteArray needle;
+    QRegularExpression regex;
+    bool nameOnly = false;
+    bool fixed = true;
+    QList<QRegularExpression> patterns;
+    QList<QRegularExpression> excludePatterns;   // 以 ! 开头的过滤条件，与 rg 的 --glob=! 一致
+};
+
+#endif // ARCHIVEWORKER_H
@@ -0,0 +1,8 @@
+# 性能回归测试：fake_rg 按指定速率回放结果，perfbench 生成语料并输出 JSON 报告
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    fakerg \
+    perfbench
+
+perfbench.depends = fakerg
@@ -0,0 +1,12 @@
+QT       += core
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = fake_rg
+TEMPLATE = app
+DESTDIR = $$OUT_PWD/../bin
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,96 @@
+#include <QCoreApplication>
+#include <QFile>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QByteArrayList>
+#include <cstdio>
+
+// rg.exe 替身：忽略搜索参数，按设定速率回放预先生成的结果列表
+// 由环境变量控制，因为调用方（SearchWorker）只会传 rg 的参数：
+//   FAKE_RG_INPUT     结果列表文件，每行一个路径；未设置时遍历最后一个参数给出的目录
+//   FAKE_RG_RATE      每秒输出行数，0 表示不限速（默认 0）
+//   FAKE_RG_CHUNK     每次写出的行数（默认 64）
+//   FAKE_RG_DELAY_MS  输出第一行之前的延迟，模拟目录遍历开销（默认 0）
+//   FAKE_RG_LIMIT     最多输出的行数，0 表示全部（默认 0）
+
+static qint64 envNumber(const char *name, qint64 defaultValue)
+{
+    bool ok = false;
+    qint64 value = qEnvironmentVariable(name).toLongLong(&ok);
+    return ok ? value : defaultValue;
+}
+
+static QByteArrayList loadLines(const QStringList &arguments)
+{
+    QByteArrayList lines;
+    QString input = qEnvironmentVariable("FAKE_RG_INPUT");
+    if (!input.isEmpty()) {
+        QFile file(input);
+        if (file.open(QIODevice::ReadOnly)) {
+            while (!file.atEnd()) {
+                QByteArray line = file.readLine().trimmed();
+                if (!line.isEmpty()) {
+                    lines << line;
+                }
+            }
+        }
+        return lines;
+    }
+    if (arguments.size() > 1) {
+        QDirIterator it(arguments.last(), QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            lines << it.next().toUtf8();
+        }
+    }
+    return lines;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+
+    if (arguments.contains("--version")) {
+        std::fputs("ripgrep 14.1.0 (fake_rg)\n", stdout);
+        return 0;
+    }
+
+    QByteArrayList lines = loadLines(arguments);
+    const qint64 rate = envNumber("FAKE_RG_RATE", 0);
+    const qint64 chunk = qMax<qint64>(1, envNumber("FAKE_RG_CHUNK", 64));
+    const qint64 delayMs = envNumber("FAKE_RG_DELAY_MS", 0);
+    const qint64 limit = envNumber("FAKE_RG_LIMIT", 0);
+    if (limit > 0 && lines.size() > limit) {
+        lines = lines.mid(0, limit);
+    }
+
+    if (delayMs > 0) {
+        QThread::msleep(delayMs);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray block;
+    for (qsizetype i = 0; i < lines.size(); i += chunk) {
+        block.clear();
+        qsizetype end = qMin<qsizetype>(lines.size(), i + chunk);
+        for (qsizetype j = i; j < end; ++j) {
+            block += lines[j];
+            block += '\n';
+        }
+        if (rate > 0) {
+            // 第 i 行应在 i / rate 秒时输出
+            qint64 dueMs = i * 1000 / rate;
+            qint64 waitMs = dueMs - timer.elapsed();
+            if (waitMs > 0) {
+                QThread::msleep(waitMs);
+            }
+        }
+        std::fwrite(block.constData(), 1, block.size(), stdout);
+        std::fflush(stdout);
+    }
+
+    // 与 rg 一致：有结果返回 0，无结果返回 1
+    return lines.isEmpty() ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+#include "corpus.h"
+#include <QDir>
+#include <QFile>
+
+static const char *const kWords[] = {
+    "alpha", "build", "cache", "delta", "error", "frame", "graph", "index",
+    "japan", "kernel", "linker", "module", "native", "object", "packet", "query",
+    "render", "shader", "thread", "update", "vector", "widget", "xml", "yield"
+};
+
+static const char *const kCjkSegments[] = {
+    "日志归档", "构建输出", "测试数据", "性能分析", "配置文件", "项目资料", "临时缓存", "版本发布"
+};
+static const int kCjkSegmentCount = int(sizeof(kCjkSegments) / sizeof(kCjkSegments[0]));
+
+QJsonObject CorpusOptions::toJson() const
+{
+    QJsonObject obj;
+    obj["file_count"] = fileCount;
+    obj["depth"] = depth;
+    obj["fanout"] = fanout;
+    obj["min_size"] = minSize;
+    obj["max_size"] = maxSize;
+    obj["cjk_paths"] = cjkPaths;
+    obj["seed"] = QString::number(seed);
+    obj["needle_ratio"] = needleRatio;
+    return obj;
+}
+
+CorpusGenerator::CorpusGenerator(const CorpusOptions &options)
+    : opts(options)
+    , state(options.seed)
+{
+}
+
+quint64 CorpusGenerator::next()
+{
+    // splitmix64：不依赖标准库分布的实现，保证跨平台结果一致
+    quint64 z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+quint64 CorpusGenerator::nextBelow(quint64 bound)
+{
+    return bound == 0 ? 0 : next() % bound;
+}
+
+QString CorpusGenerator::segmentName(int level, int index) const
+{
+    if (!opts.cjkPaths) {
+        return QString("dir_%1_%2").arg(level).arg(index);
+    }
+    return QString("%1_%2_第%3层_%4")
+        .arg(QString::fromUtf8(kCjkSegments[(level + index) % kCjkSegmentCount]),
+             QString::fromUtf8(kCjkSegments[(level * 3 + index) % kCjkSegmentCount]))
+        .arg(level)
+        .arg(index);
+}
+
+QByteArray CorpusGenerator::fileContent(qint64 size, bool withNeedle)
+{
+    const int wordCount = int(sizeof(kWords) / sizeof(kWords[0]));
+    QByteArray content;
+    content.reserve(size + 16);
+    qint64 needleAt = withNeedle ? qint64(nextBelow(quint64(qMax<qint64>(1, size)))) : -1;
+    while (content.size() < size) {
+        if (needleAt >= 0 && content.size() >= needleAt) {
+            content += "NEEDLE ";
+            needleAt = -1;
+        }
+        content += kWords[nextBelow(wordCount)];
+        content += (nextBelow(12) == 0) ? '\n' : ' ';
+    }
+    content.truncate(size);
+    if (withNeedle && !content.contains("NEEDLE")) {
+        content += "\nNEEDLE\n";
+    }
+    return content;
+}
+
+QStringList CorpusGenerator::generate(const QString &root)
+{
+    QStringList files;
+    QDir rootDir(root);
+    if (!rootDir.mkpath(".")) {
+        return files;
+    }
+
+    for (int i = 0; i < opts.fileCount; ++i) {
+        int level = int(nextBelow(quint64(opts.depth) + 1));
+        QString relative;
+        for (int l = 0; l < level; ++l) {
+            relative += segmentName(l, int(nextBelow(quint64(qMax(1, opts.fanout))))) + "/";
+        }
+        QString dirPath = rootDir.absoluteFilePath(relative);
+        if (!QDir().mkpath(dirPath)) {
+            return QStringList();
+        }
+
+        QString fileName = opts.cjkPaths
+            ? QString("报告_%1_%2.txt").arg(i, 6, 10, QChar('0')).arg(QString::fromUtf8(kCjkSegments[i % kCjkSegmentCount]))
+            : QString("file_%1.txt").arg(i, 6, 10, QChar('0'));
+        QString filePath = QDir(dirPath).absoluteFilePath(fileName);
+
+        qint64 size = opts.minSize + qint64(nextBelow(quint64(qMax<qint64>(0, opts.maxSize - opts.minSize)) + 1));
+        bool withNeedle = nextBelow(1000000) < quint64(opts.needleRatio * 1000000);
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return QStringList();
+        }
+        file.write(fileContent(size, withNeedle));
+        files << filePath;
+    }
+    return files;
+}
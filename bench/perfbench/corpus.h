@@ -0,0 +1,41 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+
+struct CorpusOptions
+{
+    int fileCount = 20000;
+    int depth = 6;
+    int fanout = 4;            // 每层目录的子目录数
+    qint64 minSize = 0;
+    qint64 maxSize = 4096;
+    bool cjkPaths = true;      // 目录和文件名使用较长的中文片段
+    quint64 seed = 20240601;
+    double needleRatio = 0.1;  // 内容中含有 "NEEDLE" 的文件比例
+
+    QJsonObject toJson() const;
+};
+
+// 相同参数在任何平台上生成完全相同的目录结构和文件内容
+class CorpusGenerator
+{
+public:
+    explicit CorpusGenerator(const CorpusOptions &options);
+
+    // 在 root 下生成语料，返回全部文件的绝对路径；失败时返回空列表
+    QStringList generate(const QString &root);
+
+private:
+    quint64 next();
+    quint64 nextBelow(quint64 bound);
+    QString segmentName(int level, int index) const;
+    QByteArray fileContent(qint64 size, bool withNeedle);
+
+    CorpusOptions opts;
+    quint64 state;
+};
+
+#endif // CORPUS_H
@@ -0,0 +1,357 @@
+#include "corpus.h"
+#include "searchworker.h"
+#include "resulttable.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QTableWidget>
+#include <cstdio>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// 单个场景的阈值，负数表示不检查
+struct Threshold
+{
+    double maxTtfrMs = -1;
+    double minRowsPerSec = -1;
+    double maxPeakRssMb = -1;
+};
+
+struct ScenarioResult
+{
+    QString name;
+    qint64 rows = 0;
+    double ttfrMs = -1;       // time to first result
+    double elapsedMs = 0;
+    double rowsPerSec = 0;     // 首条结果之后的持续吞吐
+    double peakRssMb = -1;     // 本场景期间测试进程的常驻内存峰值，不含 rg 子进程
+    int exitCode = -1;
+    bool timedOut = false;
+};
+
+struct Scenario
+{
+    QString name;
+    QString exePath;
+    QStringList arguments;
+    QHash<QString, QString> environment;
+    bool fillTable = false;
+};
+
+// 当前常驻内存（MB）；场景内多次采样取最大值，得到各场景自己的峰值
+static double currentRssMb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize / (1024.0 * 1024.0);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX)
+    // statm 第二项为常驻页数
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields[1].toLongLong() * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+#else
+    // 其他平台只能取到整个进程的历史峰值
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss / (1024.0 * 1024.0);   // macOS 单位为字节
+#endif
+}
+
+static ScenarioResult runScenario(const Scenario &scenario, int timeoutMs)
+{
+    ScenarioResult result;
+    result.name = scenario.name;
+
+    for (auto it = scenario.environment.constBegin(); it != scenario.environment.constEnd(); ++it) {
+        qputenv(it.key().toLocal8Bit().constData(), it.value().toUtf8());
+    }
+
+    QTableWidget table;
+    table.setColumnCount(2);
+
+    SearchWorker *worker = new SearchWorker;
+    QThread thread;
+    worker->moveToThread(&thread);
+    QObject::connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+
+    QEventLoop loop;
+    QElapsedTimer timer;
+    auto sampleRss = [&result]() {
+        result.peakRssMb = qMax(result.peakRssMb, currentRssMb());
+    };
+    sampleRss();
+    QObject::connect(worker, &SearchWorker::resultFound, &loop, [&](const QString &name, const QString &path) {
+        if (result.rows == 0) {
+            result.ttfrMs = timer.nsecsElapsed() / 1e6;
+        }
+        ++result.rows;
+        if (scenario.fillTable) {
+            ResultTable::appendRow(&table, name, path);
+        }
+        if ((result.rows & 1023) == 0) {
+            sampleRss();
+        }
+    });
+    QObject::connect(worker, &SearchWorker::finished, &loop, [&](int exitCode, QProcess::ExitStatus) {
+        result.exitCode = exitCode;
+        loop.quit();
+    });
+    QTimer::singleShot(timeoutMs, &loop, [&]() {
+        result.timedOut = true;
+        worker->stop();
+        loop.quit();
+    });
+
+    thread.start();
+    timer.start();
+    QMetaObject::invokeMethod(worker, "start", Qt::QueuedConnection,
+                              Q_ARG(QString, scenario.exePath),
+                              Q_ARG(QStringList, scenario.arguments));
+    loop.exec();
+    // 处理 finished 之前已排队的结果
+    QCoreApplication::processEvents();
+
+    result.elapsedMs = timer.nsecsElapsed() / 1e6;
+    // 持续吞吐从首条结果开始计，不把进程启动和首条结果延迟摊进去
+    const double streamingMs = result.elapsedMs - result.ttfrMs;
+    result.rowsPerSec = result.rows > 1 && streamingMs > 0 ? (result.rows - 1) * 1000.0 / streamingMs : 0;
+    sampleRss();
+
+    worker->stop();
+    thread.quit();
+    thread.wait();
+
+    for (auto it = scenario.environment.constBegin(); it != scenario.environment.constEnd(); ++it) {
+        qunsetenv(it.key().toLocal8Bit().constData());
+    }
+    return result;
+}
+
+static Threshold thresholdFromJson(const QJsonObject &obj, const Threshold &defaults)
+{
+    Threshold threshold = defaults;
+    if (obj.contains("max_ttfr_ms")) {
+        threshold.maxTtfrMs = obj["max_ttfr_ms"].toDouble();
+    }
+    if (obj.contains("min_rows_per_sec")) {
+        threshold.minRowsPerSec = obj["min_rows_per_sec"].toDouble();
+    }
+    if (obj.contains("max_peak_rss_mb")) {
+        threshold.maxPeakRssMb = obj["max_peak_rss_mb"].toDouble();
+    }
+    return threshold;
+}
+
+static QString defaultFakeRgPath()
+{
+#if defined(Q_OS_WIN)
+    return QCoreApplication::applicationDirPath() + "/fake_rg.exe";
+#else
+    return QCoreApplication::applicationDirPath() + "/fake_rg";
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    // 表格场景需要 QApplication，无显示环境时使用 offscreen 平台
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SearchEverything 性能回归测试");
+    parser.addHelpOption();
+    QCommandLineOption filesOption("files", "语料文件数", "n", "20000");
+    QCommandLineOption depthOption("depth", "最大目录深度", "n", "6");
+    QCommandLineOption minSizeOption("min-size", "最小文件大小（字节）", "bytes", "0");
+    QCommandLineOption maxSizeOption("max-size", "最大文件大小（字节）", "bytes", "4096");
+    QCommandLineOption asciiOption("ascii", "使用 ASCII 路径（默认生成较长的中文路径）");
+    QCommandLineOption seedOption("seed", "随机种子", "n", "20240601");
+    QCommandLineOption corpusOption("corpus", "语料目录（默认使用临时目录，结束后删除）", "dir");
+    QCommandLineOption rateOption("rate", "paced 场景 fake_rg 每秒输出行数", "rows", "50000");
+    QCommandLineOption tableRowsOption("table-rows", "表格场景回放的行数", "rows", "5000");
+    QCommandLineOption fakeRgOption("fake-rg", "fake_rg 可执行文件路径", "path");
+    QCommandLineOption rgOption("rg", "真实 rg.exe 路径，指定后额外测量真实磁盘场景", "path");
+    QCommandLineOption thresholdsOption("thresholds", "阈值 JSON 文件", "file");
+    QCommandLineOption outOption("out", "报告输出文件（默认输出到标准输出）", "file");
+    QCommandLineOption timeoutOption("timeout", "单个场景超时（毫秒）", "ms", "300000");
+    parser.addOptions({ filesOption, depthOption, minSizeOption, maxSizeOption, asciiOption, seedOption,
+                        corpusOption, rateOption, tableRowsOption, fakeRgOption, rgOption,
+                        thresholdsOption, outOption, timeoutOption });
+    parser.process(app);
+
+    CorpusOptions corpusOptions;
+    corpusOptions.fileCount = parser.value(filesOption).toInt();
+    corpusOptions.depth = parser.value(depthOption).toInt();
+    corpusOptions.minSize = parser.value(minSizeOption).toLongLong();
+    corpusOptions.maxSize = qMax(corpusOptions.minSize, parser.value(maxSizeOption).toLongLong());
+    corpusOptions.cjkPaths = !parser.isSet(asciiOption);
+    corpusOptions.seed = parser.value(seedOption).toULongLong();
+
+    QTemporaryDir tempDir;
+    QString corpusRoot = parser.isSet(corpusOption) ? parser.value(corpusOption) : tempDir.path() + "/corpus";
+    QString fakeRg = parser.isSet(fakeRgOption) ? parser.value(fakeRgOption) : defaultFakeRgPath();
+    if (!QFileInfo::exists(fakeRg)) {
+        std::fprintf(stderr, "找不到 fake_rg: %s\n", qPrintable(fakeRg));
+        return 2;
+    }
+
+    QElapsedTimer corpusTimer;
+    corpusTimer.start();
+    CorpusGenerator generator(corpusOptions);
+    const QStringList files = generator.generate(corpusRoot);
+    if (files.isEmpty()) {
+        std::fprintf(stderr, "生成语料失败: %s\n", qPrintable(corpusRoot));
+        return 2;
+    }
+    qint64 corpusMs = corpusTimer.elapsed();
+
+    QString listing = tempDir.path() + "/listing.txt";
+    QFile listingFile(listing);
+    if (!listingFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::fprintf(stderr, "无法写入结果列表: %s\n", qPrintable(listing));
+        return 2;
+    }
+    for (const QString &file : files) {
+        listingFile.write(QDir::toNativeSeparators(file).toUtf8() + '\n');
+    }
+    listingFile.close();
+
+    // 阈值：内置默认值，可由 --thresholds 覆盖；顶层 max_peak_rss_mb 作为各场景内存阈值的默认值
+    double maxPeakRssMb = 1024;
+    QJsonObject thresholdsJson;
+    if (parser.isSet(thresholdsOption)) {
+        QFile thresholdsFile(parser.value(thresholdsOption));
+        if (!thresholdsFile.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "无法读取阈值文件: %s\n", qPrintable(parser.value(thresholdsOption)));
+            return 2;
+        }
+        thresholdsJson = QJsonDocument::fromJson(thresholdsFile.readAll()).object();
+        if (thresholdsJson.contains("max_peak_rss_mb")) {
+            maxPeakRssMb = thresholdsJson["max_peak_rss_mb"].toDouble();
+        }
+    }
+    Threshold burstDefault{ 1000, 20000, maxPeakRssMb };
+    Threshold pacedDefault{ 200, parser.value(rateOption).toDouble() * 0.8, maxPeakRssMb };
+    Threshold tableDefault{ 1000, 500, maxPeakRssMb };
+
+    const QStringList rgArguments = QStringList() << "--files" << "--no-messages" << corpusRoot;
+    QList<Scenario> scenarios;
+    QHash<QString, Threshold> thresholds;
+
+    // worker_burst: 不限速回放，测 SearchWorker 解析和跨线程信号通道的吞吐
+    scenarios << Scenario{ "worker_burst", fakeRg, rgArguments,
+                           { { "FAKE_RG_INPUT", listing }, { "FAKE_RG_RATE", "0" } }, false };
+    thresholds["worker_burst"] = thresholdFromJson(thresholdsJson["worker_burst"].toObject(), burstDefault);
+
+    // worker_paced: 按固定速率逐行输出，测首条结果延迟以及能否跟上输出速度
+    scenarios << Scenario{ "worker_paced", fakeRg, rgArguments,
+                           { { "FAKE_RG_INPUT", listing }, { "FAKE_RG_RATE", parser.value(rateOption) },
+                             { "FAKE_RG_CHUNK", "1" } }, false };
+    thresholds["worker_paced"] = thresholdFromJson(thresholdsJson["worker_paced"].toObject(), pacedDefault);
+
+    // table: 用 MainWindow 同一份 ResultTable::appendRow 逐行插入 QTableWidget
+    scenarios << Scenario{ "table", fakeRg, rgArguments,
+                           { { "FAKE_RG_INPUT", listing }, { "FAKE_RG_LIMIT", parser.value(tableRowsOption) } }, true };
+    thresholds["table"] = thresholdFromJson(thresholdsJson["table"].toObject(), tableDefault);
+
+    if (parser.isSet(rgOption)) {
+        scenarios << Scenario{ "real_rg", parser.value(rgOption), rgArguments, {}, false };
+        thresholds["real_rg"] = thresholdFromJson(thresholdsJson["real_rg"].toObject(),
+                                                Threshold{ -1, -1, maxPeakRssMb });
+    }
+
+    const int timeoutMs = parser.value(timeoutOption).toInt();
+    bool passed = true;
+    QJsonArray scenarioArray;
+    for (const Scenario &scenario : std::as_const(scenarios)) {
+        ScenarioResult result = runScenario(scenario, timeoutMs);
+        const Threshold threshold = thresholds.value(scenario.name);
+
+        QJsonArray failures;
+        if (result.timedOut) {
+            failures << "timeout";
+        }
+        if (result.rows == 0) {
+            failures << "no_results";
+        }
+        if (threshold.maxTtfrMs >= 0 && (result.ttfrMs < 0 || result.ttfrMs > threshold.maxTtfrMs)) {
+            failures << "ttfr";
+        }
+        if (threshold.minRowsPerSec >= 0 && result.rowsPerSec < threshold.minRowsPerSec) {
+            failures << "rows_per_sec";
+        }
+        if (threshold.maxPeakRssMb >= 0 && result.peakRssMb > threshold.maxPeakRssMb) {
+            failures << "peak_rss";
+        }
+
+        QJsonObject obj;
+        obj["name"] = result.name;
+        obj["rows"] = result.rows;
+        obj["ttfr_ms"] = result.ttfrMs;
+        obj["elapsed_ms"] = result.elapsedMs;
+        obj["rows_per_sec"] = result.rowsPerSec;
+        obj["peak_rss_mb"] = result.peakRssMb;
+        obj["exit_code"] = result.exitCode;
+        QJsonObject thresholdObj;
+        thresholdObj["max_ttfr_ms"] = threshold.maxTtfrMs;
+        thresholdObj["min_rows_per_sec"] = threshold.minRowsPerSec;
+        thresholdObj["max_peak_rss_mb"] = threshold.maxPeakRssMb;
+        obj["threshold"] = thresholdObj;
+        obj["failures"] = failures;
+        obj["passed"] = failures.isEmpty();
+        scenarioArray << obj;
+        passed = passed && failures.isEmpty();
+        std::fprintf(stderr, "[%s] rows=%lld ttfr=%.1fms rows/s=%.0f rss=%.1fMB %s\n",
+                     qPrintable(result.name), static_cast<long long>(result.rows), result.ttfrMs, result.rowsPerSec,
+                     result.peakRssMb, failures.isEmpty() ? "OK" : "FAIL");
+    }
+
+    QJsonObject report;
+    QJsonObject corpusObj = corpusOptions.toJson();
+    corpusObj["generate_ms"] = corpusMs;
+    report["corpus"] = corpusObj;
+    report["scenarios"] = scenarioArray;
+    report["passed"] = passed;
+
+    QByteArray json = QJsonDocument(report).toJson();
+    if (parser.isSet(outOption)) {
+        QFile outFile(parser.value(outOption));
+        if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "无法写入报告: %s\n", qPrintable(parser.value(outOption)));
+            return 2;
+        }
+        outFile.write(json);
+    } else {
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+    }
+    return passed ? 0 : 1;
+}
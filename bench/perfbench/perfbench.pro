@@ -0,0 +1,25 @@
+QT       += core gui widgets network
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = perfbench
+TEMPLATE = app
+DESTDIR = $$OUT_PWD/../bin
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    corpus.cpp \
+    ../../searchworker.cpp \
+    ../../resulttable.cpp \
+    ../../daemonprotocol.cpp
+
+HEADERS += \
+    corpus.h \
+    ../../searchworker.h \
+    ../../resulttable.h \
+    ../../daemonprotocol.h
+
+win32: LIBS += -lpsapi -ladvapi32
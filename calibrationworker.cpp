@@ -0,0 +1,98 @@
+#include "calibrationworker.h"
+#include <QProcess>
+#include <QElapsedTimer>
+
+static const int kRunTimeoutMs = 120000;
+
+CalibrationWorker::CalibrationWorker(QObject *parent) : QObject(parent)
+{
+}
+
+void CalibrationWorker::stop()
+{
+    cancelled = true;
+}
+
+qint64 CalibrationWorker::measure(const QString &rgExePath, const QStringList &arguments, qint64 *rows)
+{
+    QProcess process;
+    QElapsedTimer timer;
+    qint64 lines = 0;
+
+    timer.start();
+    process.start(rgExePath, arguments);
+    if (!process.waitForStarted(5000)) {
+        return -1;
+    }
+    // 边读边数行，避免输出堆积在管道里
+    while (process.state() != QProcess::NotRunning) {
+        if (cancelled || timer.elapsed() > kRunTimeoutMs) {
+            process.kill();
+            process.waitForFinished();
+            return -1;
+        }
+        process.waitForReadyRead(100);
+        lines += process.readAllStandardOutput().count('\n');
+    }
+    lines += process.readAllStandardOutput().count('\n');
+    qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() > 1) {
+        return -1;
+    }
+    *rows = lines;
+    return elapsed;
+}
+
+void CalibrationWorker::start(const QString &rgExePath, const QStringList &baseArguments, const QString &rootPath)
+{
+    cancelled = false;
+    StorageKind kind = IoTuning::detectStorageKind(rootPath);
+    const QList<IoProfile> candidates = IoTuning::calibrationCandidates(kind);
+    const int total = candidates.size() + 1;
+
+    // 先完整跑一遍预热目录缓存，否则第一组参数会吃亏
+    emit progress(0, total, QString("预热 (%1)...").arg(IoTuning::storageKindName(kind)));
+    // 各候选只改变 I/O 参数，搜索条件相同，因此结果行数应与预热一致，按耗时比较才有意义
+    qint64 expectedRows = 0;
+    if (measure(rgExePath, baseArguments + QStringList(rootPath), &expectedRows) < 0) {
+        emit finished(false, rootPath, QJsonObject());
+        return;
+    }
+
+    qint64 bestElapsed = -1;
+    IoProfile best;
+    for (int i = 0; i < candidates.size(); ++i) {
+        const IoProfile &candidate = candidates[i];
+        QStringList arguments = baseArguments + candidate.toArguments();
+        arguments << rootPath;
+        qint64 rows = 0;
+        qint64 elapsedMs = measure(rgExePath, arguments, &rows);
+        if (cancelled) {
+            emit finished(false, rootPath, QJsonObject());
+            return;
+        }
+        QString message;
+        if (elapsedMs < 0) {
+            message = QString("%1: 失败").arg(candidate.name);
+        } else if (rows != expectedRows) {
+            // 校准期间目录内容发生变化，本次耗时不可比
+            message = QString("%1: 结果数不一致 (%2 / %3)，忽略").arg(candidate.name).arg(rows).arg(expectedRows);
+            elapsedMs = -1;
+        } else {
+            message = QString("%1: %2 行, %3 ms").arg(candidate.name).arg(rows).arg(elapsedMs);
+        }
+        emit progress(i + 1, total, message);
+        if (elapsedMs >= 0 && (bestElapsed < 0 || elapsedMs < bestElapsed)) {
+            bestElapsed = elapsedMs;
+            best = candidate;
+        }
+    }
+
+    if (bestElapsed < 0) {
+        emit finished(false, rootPath, QJsonObject());
+        return;
+    }
+    best.name = "Calibrated-" + best.name;
+    emit finished(true, rootPath, best.toJson());
+}
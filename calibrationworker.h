@@ -0,0 +1,31 @@
+#ifndef CALIBRATIONWORKER_H
+#define CALIBRATIONWORKER_H
+
+#include <QObject>
+#include <QStringList>
+#include <atomic>
+#include "iotuning.h"
+
+// 依次用不同 I/O 参数运行同一搜索，按耗时挑出最快的一组
+class CalibrationWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CalibrationWorker(QObject *parent = nullptr);
+
+public slots:
+    void start(const QString &rgExePath, const QStringList &baseArguments, const QString &rootPath);
+    void stop();
+
+signals:
+    void progress(int current, int total, const QString &message);
+    void finished(bool success, const QString &rootPath, const QJsonObject &bestProfile);
+
+private:
+    // 返回耗时（毫秒），失败或被取消时返回负数
+    qint64 measure(const QString &rgExePath, const QStringList &arguments, qint64 *rows);
+
+    std::atomic<bool> cancelled{false};
+};
+
+#endif // CALIBRATIONWORKER_H
@@ -0,0 +1,187 @@
+#include "daemonprotocol.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <QtEndian>
+#include <QDir>
+#include <QLocalSocket>
+#include <QStandardPaths>
+#include <QRegularExpression>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+static const quint32 kMaxFrameSize = 64 * 1024 * 1024;
+
+static QByteArray frame(const QByteArray &payload)
+{
+    QByteArray data(4, Qt::Uninitialized);
+    qToBigEndian<quint32>(payload.size(), data.data());
+    data.append(payload);
+    return data;
+}
+
+template <typename... Fields>
+static QByteArray encodeMessage(DaemonProtocol::MessageType type, const Fields &...fields)
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint8(type);
+    (out << ... << fields);
+    return frame(payload);
+}
+
+QString DaemonProtocol::serverName()
+{
+#ifdef Q_OS_WIN
+    // 命名管道全局可见，名字里带上用户名；访问权限由 UserAccessOption 和 isTrustedServer() 保证
+    QString user = qEnvironmentVariable("USERNAME");
+    user.replace(QRegularExpression("[^A-Za-z0-9_.-]"), "_");
+    return "SearchEverythingDaemon-" + user;
+#else
+    // 放在仅当前用户可写的运行时目录（如 $XDG_RUNTIME_DIR），其他用户既连不上也无法抢占
+    QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    if (runtimeDir.isEmpty()) {
+        runtimeDir = QDir::homePath();
+    }
+    return QDir(runtimeDir).filePath("SearchEverythingDaemon");
+#endif
+}
+
+#ifdef Q_OS_WIN
+static QByteArray tokenUserSid(HANDLE process)
+{
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(process, TOKEN_QUERY, &token)) {
+        return QByteArray();
+    }
+    DWORD size = 0;
+    GetTokenInformation(token, TokenUser, nullptr, 0, &size);
+    QByteArray buffer(int(size), Qt::Uninitialized);
+    QByteArray sid;
+    if (size > 0 && GetTokenInformation(token, TokenUser, buffer.data(), size, &size)) {
+        PSID user = reinterpret_cast<TOKEN_USER *>(buffer.data())->User.Sid;
+        sid = QByteArray(reinterpret_cast<const char *>(user), int(GetLengthSid(user)));
+    }
+    CloseHandle(token);
+    return sid;
+}
+#endif
+
+bool DaemonProtocol::isTrustedServer(QLocalSocket *socket)
+{
+#ifdef Q_OS_WIN
+    ULONG serverPid = 0;
+    HANDLE pipe = reinterpret_cast<HANDLE>(socket->socketDescriptor());
+    if (!GetNamedPipeServerProcessId(pipe, &serverPid)) {
+        return false;
+    }
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, serverPid);
+    if (!process) {
+        return false;
+    }
+    QByteArray serverSid = tokenUserSid(process);
+    CloseHandle(process);
+    return !serverSid.isEmpty() && serverSid == tokenUserSid(GetCurrentProcess());
+#else
+    // 套接字位于用户私有目录中，能连上即为本用户的服务
+    Q_UNUSED(socket);
+    return true;
+#endif
+}
+
+QByteArray DaemonProtocol::encodeSearch(quint32 requestId, const QStringList &arguments)
+{
+    return encodeMessage(Search, requestId, arguments);
+}
+
+QByteArray DaemonProtocol::encodeCancel(quint32 requestId)
+{
+    return encodeMessage(Cancel, requestId);
+}
+
+QByteArray DaemonProtocol::encodeResults(quint32 requestId, const QStringList &names, const QStringList &paths)
+{
+    return encodeMessage(Results, requestId, names, paths);
+}
+
+QByteArray DaemonProtocol::encodeFinished(quint32 requestId, qint32 exitCode, quint8 exitStatus)
+{
+    return encodeMessage(Finished, requestId, exitCode, exitStatus);
+}
+
+QByteArray DaemonProtocol::encodeError(quint32 requestId, const QString &message)
+{
+    return encodeMessage(Error, requestId, message);
+}
+
+DaemonProtocol::FrameResult DaemonProtocol::takeFrame(QByteArray &buffer, QByteArray *payload)
+{
+    if (buffer.size() < 4) {
+        return FrameIncomplete;
+    }
+    quint32 size = qFromBigEndian<quint32>(buffer.constData());
+    if (size > kMaxFrameSize) {
+        buffer.clear();
+        payload->clear();
+        return FrameInvalid;
+    }
+    if (quint32(buffer.size()) < 4 + size) {
+        return FrameIncomplete;
+    }
+    *payload = buffer.mid(4, size);
+    buffer.remove(0, 4 + size);
+    return FrameReady;
+}
+
+bool DaemonProtocol::validateSearchArguments(const QStringList &arguments, QString *error)
+{
+    static const QRegularExpression digits("^[0-9]{1,4}$");
+    const int last = arguments.size() - 1;
+    if (last < 1) {
+        *error = "参数不完整";
+        return false;
+    }
+
+    // 搜索模式：--files，或 -l [-F] -e <内容>（内容经 -e 传入，不会被当成选项解析）
+    int i = 0;
+    if (arguments[0] == "--files") {
+        i = 1;
+    } else if (arguments[0] == "-l") {
+        i = 1;
+        if (i < last && arguments[i] == "-F") {
+            ++i;
+        }
+        if (i + 1 >= last || arguments[i] != "-e") {
+            *error = "缺少搜索内容";
+            return false;
+        }
+        i += 2;
+    } else {
+        *error = "不允许的参数: " + arguments[0];
+        return false;
+    }
+
+    while (i < last) {
+        const QString &argument = arguments[i];
+        if (argument.startsWith("--glob=") || argument == "--no-messages"
+            || argument == "--mmap" || argument == "--no-mmap") {
+            i += 1;
+        } else if (argument == "--threads" && i + 1 < last && digits.match(arguments[i + 1]).hasMatch()) {
+            i += 2;
+        } else if (argument == "--sort" && i + 1 < last && arguments[i + 1] == "path") {
+            i += 2;
+        } else {
+            *error = "不允许的参数: " + argument;
+            return false;
+        }
+    }
+
+    const QString &root = arguments[last];
+    if (root.startsWith('-') || !QDir::isAbsolutePath(root)) {
+        *error = "搜索目录必须是绝对路径";
+        return false;
+    }
+    return true;
+}
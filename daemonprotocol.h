@@ -0,0 +1,48 @@
+#ifndef DAEMONPROTOCOL_H
+#define DAEMONPROTOCOL_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+class QLocalSocket;
+
+// 后台服务与客户端之间的二进制协议
+// 每帧: quint32 长度（大端） + 负载；负载首字节为消息类型，其余字段用 QDataStream 序列化
+class DaemonProtocol
+{
+public:
+    enum MessageType : quint8 {
+        Search = 1,    // 客户端 -> 服务: requestId, arguments
+        Cancel = 2,    // 客户端 -> 服务: requestId
+        Results = 3,   // 服务 -> 客户端: requestId, names, paths（增量）
+        Finished = 4,  // 服务 -> 客户端: requestId, exitCode, exitStatus
+        Error = 5      // 服务 -> 客户端: requestId, message
+    };
+
+    // 每个用户一个服务，不同账户之间不共享搜索进程和结果缓存
+    static QString serverName();
+    // 确认连上的服务进程属于当前用户，防止他人抢先创建同名管道冒充服务
+    static bool isTrustedServer(QLocalSocket *socket);
+
+    static QByteArray encodeSearch(quint32 requestId, const QStringList &arguments);
+    static QByteArray encodeCancel(quint32 requestId);
+    static QByteArray encodeResults(quint32 requestId, const QStringList &names, const QStringList &paths);
+    static QByteArray encodeFinished(quint32 requestId, qint32 exitCode, quint8 exitStatus);
+    static QByteArray encodeError(quint32 requestId, const QString &message);
+
+    enum FrameResult {
+        FrameIncomplete,  // 数据不足，等待更多数据
+        FrameReady,       // 已取出一帧负载
+        FrameInvalid      // 长度超限，流已无法同步，调用方必须断开连接
+    };
+
+    // 从缓冲区取出一帧完整负载
+    static FrameResult takeFrame(QByteArray &buffer, QByteArray *payload);
+
+    // 只接受客户端 buildSearchArguments() 与 IoProfile::toArguments() 会生成的参数，
+    // 最后一项必须是搜索根目录（绝对路径）
+    static bool validateSearchArguments(const QStringList &arguments, QString *error);
+};
+
+#endif // DAEMONPROTOCOL_H
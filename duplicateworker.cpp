@@ -0,0 +1,228 @@
+#include "duplicateworker.h"
+#include "xxhash3.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+
+static const qint64 kEdgeSize = 4096;                    // 首尾各读 4 KB
+static const qint64 kMapWindow = 16 * 1024 * 1024;      // 完整哈希时每次映射 16 MB
+
+namespace {
+
+struct FileItem
+{
+    QString path;
+    qint64 size = 0;
+    quint64 hash = 0;
+    bool ok = false;
+};
+
+using GroupKey = QPair<qint64, quint64>;
+
+} // namespace
+
+DuplicateWorker::DuplicateWorker(QObject *parent) : QObject(parent)
+{
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+}
+
+void DuplicateWorker::stop()
+{
+    cancelled = true;
+}
+
+bool DuplicateWorker::runParallel(Stage stage, int count, const std::function<void(int)> &task)
+{
+    std::atomic<int> next{0};
+    std::atomic<qint64> done{0};
+    for (int t = 0; t < pool.maxThreadCount(); ++t) {
+        pool.start([&]() {
+            int index;
+            while (!cancelled && (index = next++) < count) {
+                task(index);
+                ++done;
+            }
+        });
+    }
+    // 工作线程自己不处理事件，这里轮询并上报进度
+    while (!pool.waitForDone(100)) {
+        emit progress(stage, done, count);
+    }
+    emit progress(stage, done, count);
+    return !cancelled;
+}
+
+quint64 DuplicateWorker::partialHash(const QString &path, qint64 size, bool *ok)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *ok = false;
+        return 0;
+    }
+    // 不超过 8 KB 的文件这里已经读到全部内容
+    char buffer[2 * kEdgeSize];
+    qint64 length = file.read(buffer, qMin(size, kEdgeSize));
+    if (length != qMin(size, kEdgeSize)) {
+        *ok = false;
+        return 0;
+    }
+    if (size > kEdgeSize) {
+        qint64 tailStart = qMax(kEdgeSize, size - kEdgeSize);
+        if (!file.seek(tailStart)) {
+            *ok = false;
+            return 0;
+        }
+        length += file.read(buffer + length, size - tailStart);
+    }
+    if (length != qMin(size, 2 * kEdgeSize)) {
+        *ok = false;
+        return 0;
+    }
+    bytesRead += length;
+    *ok = true;
+    return xxHash3(buffer, size_t(length));
+}
+
+quint64 DuplicateWorker::fullHash(const QString &path, qint64 size, bool *ok)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *ok = false;
+        return 0;
+    }
+    // 分窗口映射，每个窗口单独哈希后再对窗口摘要整体哈希，地址空间占用有上限
+    QVector<quint64> digests;
+    digests.reserve(int(size / kMapWindow) + 1);
+    for (qint64 offset = 0; offset < size && !cancelled; offset += kMapWindow) {
+        const qint64 length = qMin(kMapWindow, size - offset);
+        if (uchar *mapped = file.map(offset, length)) {
+            digests << xxHash3(mapped, size_t(length));
+            file.unmap(mapped);
+        } else {
+            // 无法映射（如部分网络文件系统）时退回普通读取
+            if (!file.seek(offset)) {
+                *ok = false;
+                return 0;
+            }
+            const QByteArray data = file.read(length);
+            if (data.size() != length) {
+                *ok = false;
+                return 0;
+            }
+            digests << xxHash3(data.constData(), size_t(length));
+        }
+        bytesRead += length;
+    }
+    *ok = !cancelled;
+    return xxHash3(digests.constData(), size_t(digests.size()) * sizeof(quint64));
+}
+
+void DuplicateWorker::start(const QStringList &files)
+{
+    cancelled = false;
+    bytesRead = 0;
+    QVector<FileItem> items(files.size());
+    QList<QPair<qint64, QStringList>> found;
+    auto addGroup = [&](const QVector<int> &indexes) {
+        QStringList group;
+        for (int index : indexes) {
+            group << items[index].path;
+        }
+        group.sort();
+        found << qMakePair(items[indexes.first()].size, group);
+    };
+
+    // 第一步：按大小分组，大小唯一的文件不可能重复
+    qint64 totalBytes = 0;
+    QHash<qint64, QVector<int>> bySize;
+    for (int i = 0; i < files.size() && !cancelled; ++i) {
+        QFileInfo info(files[i]);
+        if (!info.isFile()) {
+            continue;
+        }
+        items[i].path = info.absoluteFilePath();
+        items[i].size = info.size();
+        totalBytes += items[i].size;
+        bySize[items[i].size] << i;
+        if (i % 1000 == 0) {
+            emit progress(SizeStage, i, files.size());
+        }
+    }
+    emit progress(SizeStage, files.size(), files.size());
+
+    QVector<int> candidates;
+    for (auto it = bySize.constBegin(); it != bySize.constEnd(); ++it) {
+        if (it.value().size() < 2) {
+            continue;
+        }
+        if (it.key() == 0) {
+            // 空文件彼此相同，无需读取
+            addGroup(it.value());
+            continue;
+        }
+        candidates << it.value();
+    }
+
+    // 第二步：只读首尾 4 KB
+    if (!runParallel(PartialHashStage, candidates.size(), [&](int k) {
+            FileItem &item = items[candidates[k]];
+            item.hash = partialHash(item.path, item.size, &item.ok);
+        })) {
+        emit finished(false, QList<QStringList>(), bytesRead, totalBytes);
+        return;
+    }
+
+    QHash<GroupKey, QVector<int>> byPartial;
+    for (int index : std::as_const(candidates)) {
+        if (items[index].ok) {
+            byPartial[GroupKey(items[index].size, items[index].hash)] << index;
+        }
+    }
+    candidates.clear();
+    for (auto it = byPartial.constBegin(); it != byPartial.constEnd(); ++it) {
+        if (it.value().size() < 2) {
+            continue;
+        }
+        if (it.key().first <= 2 * kEdgeSize) {
+            // 小文件在第二步已完整哈希
+            addGroup(it.value());
+            continue;
+        }
+        candidates << it.value();
+    }
+
+    // 第三步：对剩余候选做完整哈希
+    if (!runParallel(FullHashStage, candidates.size(), [&](int k) {
+            FileItem &item = items[candidates[k]];
+            item.hash = fullHash(item.path, item.size, &item.ok);
+        })) {
+        emit finished(false, QList<QStringList>(), bytesRead, totalBytes);
+        return;
+    }
+
+    QHash<GroupKey, QVector<int>> byFull;
+    for (int index : std::as_const(candidates)) {
+        if (items[index].ok) {
+            byFull[GroupKey(items[index].size, items[index].hash)] << index;
+        }
+    }
+    for (auto it = byFull.constBegin(); it != byFull.constEnd(); ++it) {
+        if (it.value().size() >= 2) {
+            addGroup(it.value());
+        }
+    }
+
+    // 按可节省的空间（大小 x (份数 - 1)）排序
+    std::sort(found.begin(), found.end(), [](const QPair<qint64, QStringList> &a, const QPair<qint64, QStringList> &b) {
+        return a.first * (a.second.size() - 1) > b.first * (b.second.size() - 1);
+    });
+    QList<QStringList> groups;
+    for (const auto &entry : std::as_const(found)) {
+        groups << entry.second;
+    }
+    emit finished(true, groups, bytesRead, totalBytes);
+}
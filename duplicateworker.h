@@ -0,0 +1,43 @@
+#ifndef DUPLICATEWORKER_H
+#define DUPLICATEWORKER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+#include <QList>
+#include <atomic>
+#include <functional>
+
+// 重复文件检测，分三步逐步缩小范围：按大小分组 -> 首尾 4 KB 哈希 -> 完整哈希
+class DuplicateWorker : public QObject
+{
+    Q_OBJECT
+public:
+    enum Stage {
+        SizeStage = 1,
+        PartialHashStage = 2,
+        FullHashStage = 3
+    };
+
+    explicit DuplicateWorker(QObject *parent = nullptr);
+
+public slots:
+    void start(const QStringList &files);
+    void stop();
+
+signals:
+    void progress(int stage, qint64 done, qint64 total);
+    // groups 按可节省空间从大到小排列；bytesRead 为实际读取的字节数
+    void finished(bool completed, const QList<QStringList> &groups, qint64 bytesRead, qint64 totalBytes);
+
+private:
+    bool runParallel(Stage stage, int count, const std::function<void(int)> &task);
+    quint64 partialHash(const QString &path, qint64 size, bool *ok);
+    quint64 fullHash(const QString &path, qint64 size, bool *ok);
+
+    QThreadPool pool;
+    std::atomic<bool> cancelled{false};
+    std::atomic<qint64> bytesRead{0};
+};
+
+#endif // DUPLICATEWORKER_H
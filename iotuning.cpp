@@ -0,0 +1,224 @@
+#include "iotuning.h"
+#include <QStorageInfo>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QThread>
+#include <QtGlobal>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <winioctl.h>
+#endif
+
+QStringList IoProfile::toArguments() const
+{
+    QStringList args;
+    if (threads > 0) {
+        args << "--threads" << QString::number(threads);
+    }
+    args << (useMmap ? "--mmap" : "--no-mmap");
+    if (sortByPath) {
+        args << "--sort" << "path";
+    }
+    return args;
+}
+
+QString IoProfile::describe() const
+{
+    return QString("%1 (线程: %2, mmap: %3, 顺序遍历: %4)")
+        .arg(name)
+        .arg(threads > 0 ? QString::number(threads) : QString("自动"))
+        .arg(useMmap ? "开" : "关")
+        .arg(sortByPath ? "是" : "否");
+}
+
+QJsonObject IoProfile::toJson() const
+{
+    QJsonObject obj;
+    obj["name"] = name;
+    obj["threads"] = threads;
+    obj["mmap"] = useMmap;
+    obj["sort_path"] = sortByPath;
+    return obj;
+}
+
+IoProfile IoProfile::fromJson(const QJsonObject &obj)
+{
+    IoProfile profile;
+    profile.name = obj["name"].toString();
+    profile.threads = obj["threads"].toInt();
+    profile.useMmap = obj["mmap"].toBool();
+    profile.sortByPath = obj["sort_path"].toBool();
+    return profile;
+}
+
+static bool isNetworkFileSystem(const QByteArray &fsType)
+{
+    static const QList<QByteArray> networkTypes = {
+        "nfs", "nfs4", "cifs", "smb3", "smbfs", "9p", "afs",
+        "ceph", "glusterfs", "fuse.sshfs", "fuse.glusterfs", "webdav"
+    };
+    return networkTypes.contains(fsType.toLower());
+}
+
+#ifdef Q_OS_WIN
+static StorageKind detectWindowsDrive(const QString &rootPath)
+{
+    std::wstring root = QDir::toNativeSeparators(rootPath).toStdWString();
+    if (GetDriveTypeW(root.c_str()) == DRIVE_REMOTE) {
+        return StorageKind::Network;
+    }
+
+    // 通过卷设备查询是否存在寻道开销（机械硬盘）
+    QString drive = rootPath.left(2);
+    if (drive.length() != 2 || drive[1] != ':') {
+        return StorageKind::Unknown;
+    }
+    std::wstring device = (QString("\\\\.\\") + drive).toStdWString();
+    HANDLE handle = CreateFileW(device.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                nullptr, OPEN_EXISTING, 0, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return StorageKind::Unknown;
+    }
+
+    STORAGE_PROPERTY_QUERY query = {};
+    query.PropertyId = StorageDeviceSeekPenaltyProperty;
+    query.QueryType = PropertyStandardQuery;
+    DEVICE_SEEK_PENALTY_DESCRIPTOR penalty = {};
+    DWORD bytes = 0;
+    BOOL ok = DeviceIoControl(handle, IOCTL_STORAGE_QUERY_PROPERTY,
+                              &query, sizeof(query), &penalty, sizeof(penalty),
+                              &bytes, nullptr);
+    CloseHandle(handle);
+    if (!ok || bytes < sizeof(penalty)) {
+        return StorageKind::Unknown;
+    }
+    return penalty.IncursSeekPenalty ? StorageKind::Rotational : StorageKind::SolidState;
+}
+#endif
+
+#ifdef Q_OS_LINUX
+static StorageKind detectLinuxDevice(const QByteArray &device)
+{
+    // /dev/mapper/xxx 等是符号链接，先解析到真实块设备（如 /dev/dm-0）
+    QString devPath = QFileInfo(QString::fromLocal8Bit(device)).canonicalFilePath();
+    if (!devPath.startsWith("/dev/")) {
+        return StorageKind::Unknown;
+    }
+    QString sysPath = "/sys/class/block/" + QFileInfo(devPath).fileName();
+
+    // 分区没有 queue 目录，需要回到所属磁盘查找
+    QStringList candidates;
+    candidates << sysPath + "/queue/rotational";
+    candidates << QFileInfo(sysPath).canonicalFilePath() + "/../queue/rotational";
+    for (const QString &candidate : candidates) {
+        QFile file(candidate);
+        if (file.open(QIODevice::ReadOnly)) {
+            QByteArray value = file.readAll().trimmed();
+            return value == "1" ? StorageKind::Rotational : StorageKind::SolidState;
+        }
+    }
+    return StorageKind::Unknown;
+}
+#endif
+
+StorageKind IoTuning::detectStorageKind(const QString &rootPath)
+{
+    if (rootPath.startsWith("//") || rootPath.startsWith("\\\\")) {
+        return StorageKind::Network;
+    }
+
+    QStorageInfo storage(rootPath);
+    if (!storage.isValid()) {
+        return StorageKind::Unknown;
+    }
+    if (isNetworkFileSystem(storage.fileSystemType())) {
+        return StorageKind::Network;
+    }
+
+#if defined(Q_OS_WIN)
+    return detectWindowsDrive(storage.rootPath());
+#elif defined(Q_OS_LINUX)
+    return detectLinuxDevice(storage.device());
+#else
+    return StorageKind::Unknown;
+#endif
+}
+
+QString IoTuning::storageKindName(StorageKind kind)
+{
+    switch (kind) {
+    case StorageKind::SolidState:
+        return "固态硬盘";
+    case StorageKind::Rotational:
+        return "机械硬盘";
+    case StorageKind::Network:
+        return "网络共享";
+    default:
+        return "未知";
+    }
+}
+
+IoProfile IoTuning::profileForStorage(StorageKind kind)
+{
+    const int cores = qMax(1, QThread::idealThreadCount());
+    IoProfile profile;
+    switch (kind) {
+    case StorageKind::SolidState:
+        // 固态硬盘随机读开销低，线程跑满，大量小文件时普通读取比 mmap 更快
+        profile.name = "SSD";
+        profile.threads = cores;
+        profile.useMmap = false;
+        break;
+    case StorageKind::Rotational:
+        // 机械硬盘并发读取会导致磁头来回寻道，按路径顺序单线程遍历
+        profile.name = "HDD";
+        profile.threads = 1;
+        profile.useMmap = false;
+        profile.sortByPath = true;
+        break;
+    case StorageKind::Network:
+        // 网络共享受延迟限制，多开线程掩盖往返时间；mmap 在网络文件上不可靠
+        profile.name = "Network";
+        profile.threads = qMin(cores * 2, 16);
+        profile.useMmap = false;
+        break;
+    default:
+        profile.name = "Default";
+        break;
+    }
+    return profile;
+}
+
+QList<IoProfile> IoTuning::calibrationCandidates(StorageKind kind)
+{
+    const int cores = qMax(1, QThread::idealThreadCount());
+    QList<IoProfile> candidates;
+    candidates << profileForStorage(kind);
+
+    QList<int> threadCounts;
+    threadCounts << 1 << qMax(1, cores / 2) << cores << qMin(cores * 2, 16);
+    for (int threads : threadCounts) {
+        for (bool mmap : { false, true }) {
+            if (kind == StorageKind::Network && mmap) {
+                continue;
+            }
+            IoProfile profile;
+            profile.name = QString("T%1%2").arg(threads).arg(mmap ? "-mmap" : "");
+            profile.threads = threads;
+            profile.useMmap = mmap;
+            bool duplicate = false;
+            for (const IoProfile &existing : candidates) {
+                if (existing.toArguments() == profile.toArguments()) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (!duplicate) {
+                candidates << profile;
+            }
+        }
+    }
+    return candidates;
+}
@@ -0,0 +1,41 @@
+#ifndef IOTUNING_H
+#define IOTUNING_H
+
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QList>
+
+// 搜索根目录所在存储的类型
+enum class StorageKind {
+    Unknown,
+    SolidState,
+    Rotational,
+    Network
+};
+
+// 一组 rg.exe I/O 参数（线程数、mmap、遍历顺序），只影响读取方式，不改变搜索结果
+struct IoProfile
+{
+    QString name;
+    int threads = 0;          // 0 表示交给 rg.exe 自行决定
+    bool useMmap = false;
+    bool sortByPath = false;  // 按路径顺序遍历，机械硬盘可减少寻道（rg 会退化为单线程）
+
+    QStringList toArguments() const;
+    QString describe() const;
+    QJsonObject toJson() const;
+    static IoProfile fromJson(const QJsonObject &obj);
+};
+
+class IoTuning
+{
+public:
+    static StorageKind detectStorageKind(const QString &rootPath);
+    static QString storageKindName(StorageKind kind);
+    static IoProfile profileForStorage(StorageKind kind);
+    // 校准时依次尝试的候选参数
+    static QList<IoProfile> calibrationCandidates(StorageKind kind);
+};
+
+#endif // IOTUNING_H
@@ -1,8 +1,21 @@
 #include "mainwindow.h"
+#include "searchdaemon.h"
 #include <QApplication>
+#include <QCoreApplication>
+#include <cstring>
 
 int main(int argc, char *argv[])
 {
+    // --daemon: 以无界面的后台服务方式运行，供多个客户端共享
+    if (argc > 1 && std::strcmp(argv[1], "--daemon") == 0) {
+        QCoreApplication app(argc, argv);
+        SearchDaemon daemon;
+        if (!daemon.listen()) {
+            return 1;
+        }
+        return app.exec();
+    }
+
     QApplication app(argc, argv);
     MainWindow window;
     window.show();
@@ -18,6 +18,13 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QProcess>
+#include <QColor>
+#include <QFont>
+#include <QDialog>
+#include <QTreeWidget>
+#include <QDialogButtonBox>
+#include "searchdaemon.h"
+#include "resulttable.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -43,7 +50,10 @@ MainWindow::MainWindow(QWidget *parent)
 MainWindow::~MainWindow()
 {
     if (searchThread) {
-        searchWorker->stop();
+        if (searchWorker)
+            searchWorker->stop();
+        if (archiveWorker)
+            archiveWorker->stop();
         searchThread->quit();
         searchThread->wait();
         delete searchThread;
@@ -53,6 +63,19 @@ MainWindow::~MainWindow()
         exportThread->wait();
         delete exportThread;
     }
+    if (calibrationThread) {
+        calibrationWorker->stop();
+        calibrationThread->quit();
+        calibrationThread->wait();
+        delete calibrationThread;
+    }
+    if (duplicateThread) {
+        duplicateWorker->stop();
+        duplicateThread->quit();
+        duplicateThread->wait();
+        delete duplicateThread;
+    }
+    stopWatch();
     if (logFile.isOpen()) {
         logFile.close();
     }
@@ -116,8 +139,32 @@ void MainWindow::setupUI()
     fixedStringRadio->setChecked(true);
     matchModeLayout->addWidget(fixedStringRadio);
     matchModeLayout->addWidget(regexRadio);
+    archiveCheck = new QCheckBox("搜索压缩包内容", this);
+    archiveCheck->setToolTip("在 zip/tar/gz/zst 压缩包内流式搜索，不解压到磁盘；结果路径形如 压缩包!/内部路径");
+    matchModeLayout->addWidget(archiveCheck);
     mainLayout->addLayout(matchModeLayout);
 
+    // I/O 参数配置区域
+    QHBoxLayout *ioLayout = new QHBoxLayout();
+    ioProfileCombo = new QComboBox(this);
+    ioProfileCombo->addItem("自动检测", "auto");
+    ioProfileCombo->addItem("固态硬盘", "ssd");
+    ioProfileCombo->addItem("机械硬盘", "hdd");
+    ioProfileCombo->addItem("网络共享", "network");
+    ioProfileCombo->addItem("rg.exe 默认", "default");
+    calibrateButton = new QPushButton("校准I/O", this);
+    storageLabel = new QLabel(this);
+    ioLayout->addWidget(new QLabel("I/O 配置:", this));
+    ioLayout->addWidget(ioProfileCombo);
+    ioLayout->addWidget(calibrateButton);
+    ioLayout->addWidget(storageLabel);
+    ioLayout->addStretch();
+    useDaemonCheck = new QCheckBox("使用后台服务", this);
+    useDaemonCheck->setChecked(false);
+    useDaemonCheck->setToolTip("同一用户的多个实例共享一个后台搜索服务和结果缓存（服务空闲 30 分钟后退出），服务不可用时自动改为本地搜索");
+    ioLayout->addWidget(useDaemonCheck);
+    mainLayout->addLayout(ioLayout);
+
     // rg.exe 命令显示区域
     cmdDisplayEdit = new QLineEdit(this);
     cmdDisplayEdit->setReadOnly(true);
@@ -129,10 +176,17 @@ void MainWindow::setupUI()
     searchButton = new QPushButton("搜索", this);
     stopButton = new QPushButton("停止", this);
     exportButton = new QPushButton("导出...", this);
+    watchButton = new QPushButton("监视变化", this);
+    watchButton->setCheckable(true);
+    watchButton->setToolTip("搜索完成后监视目录变化，自动增删结果，新增结果高亮显示");
+    duplicateButton = new QPushButton("查找重复文件", this);
+    duplicateButton->setToolTip("在当前结果中查找内容相同的文件：先按大小分组，再比较首尾 4 KB，最后完整哈希");
     stopButton->setEnabled(false);
     buttonLayout->addWidget(searchButton);
     buttonLayout->addWidget(stopButton);
     buttonLayout->addWidget(exportButton);
+    buttonLayout->addWidget(watchButton);
+    buttonLayout->addWidget(duplicateButton);
     mainLayout->addLayout(buttonLayout);
 
     // 结果显示区域（表格）
@@ -172,6 +226,19 @@ void MainWindow::setupUI()
     connect(fixedStringRadio, &QRadioButton::toggled, this, &MainWindow::updateButtonsState);
     connect(regexRadio, &QRadioButton::toggled, this, &MainWindow::updateButtonsState);
     connect(checkRgVersionButton, &QPushButton::clicked, this, &MainWindow::onCheckRgVersionClicked);
+    connect(calibrateButton, &QPushButton::clicked, this, &MainWindow::onCalibrateClicked);
+    connect(watchButton, &QPushButton::toggled, this, &MainWindow::onWatchToggled);
+    connect(duplicateButton, &QPushButton::clicked, this, &MainWindow::onFindDuplicatesClicked);
+    connect(useDaemonCheck, &QCheckBox::toggled, this, [this](bool checked) {
+        if (checked && !SearchDaemon::isRunning()) {
+            SearchDaemon::launch();
+        }
+        saveConfig();
+    });
+    connect(ioProfileCombo, &QComboBox::currentIndexChanged, this, [this]() {
+        updateStorageInfo();
+        saveConfig();
+    });
 }
 
 void MainWindow::loadConfig()
@@ -204,9 +271,34 @@ void MainWindow::loadConfig()
                 }
             }
         }
+
+        // 加载 I/O 配置及各目录的校准结果
+        if (obj.contains("io_mode")) {
+            int index = ioProfileCombo->findData(obj["io_mode"].toString());
+            if (index >= 0) {
+                QSignalBlocker blocker(ioProfileCombo);
+                ioProfileCombo->setCurrentIndex(index);
+            }
+        }
+        if (obj.contains("use_daemon")) {
+            QSignalBlocker blocker(useDaemonCheck);
+            useDaemonCheck->setChecked(obj["use_daemon"].toBool());
+        }
+        if (obj.contains("io_profiles") && obj["io_profiles"].isObject()) {
+            QJsonObject profiles = obj["io_profiles"].toObject();
+            for (auto it = profiles.begin(); it != profiles.end(); ++it) {
+                calibratedProfiles.insert(it.key(), it.value().toObject());
+            }
+        }
         
         configFile.close();
     }
+    updateStorageInfo();
+
+    // 用户启用了后台服务且服务未运行时拉起，供本用户的其他实例共享
+    if (useDaemonCheck->isChecked() && !SearchDaemon::isRunning()) {
+        writeLog(QString("[后台服务] 启动%1").arg(SearchDaemon::launch() ? "成功" : "失败"));
+    }
 }
 
 void MainWindow::saveConfig()
@@ -224,6 +316,15 @@ void MainWindow::saveConfig()
         QJsonArray dirs;
         dirs.append(currentPath);
         obj["search_directories"] = dirs;
+
+        // 保存 I/O 配置及校准结果
+        obj["io_mode"] = ioProfileCombo->currentData().toString();
+        obj["use_daemon"] = useDaemonCheck->isChecked();
+        QJsonObject profiles;
+        for (auto it = calibratedProfiles.constBegin(); it != calibratedProfiles.constEnd(); ++it) {
+            profiles[it.key()] = it.value();
+        }
+        obj["io_profiles"] = profiles;
         
         QJsonDocument doc(obj);
         configFile.write(doc.toJson());
@@ -257,6 +358,7 @@ void MainWindow::onBrowseDirClicked()
     if (!dir.isEmpty()) {
         pathEdit->setText(dir);
         currentPath = dir;
+        updateStorageInfo();
         updateButtonsState();
         saveConfig(); // 保存配置
     }
@@ -267,10 +369,13 @@ void MainWindow::updateButtonsState()
     bool hasRgExe = checkRgExe(false);
     bool hasSearchDir = !currentPath.isEmpty();
     bool hasFileType = !fileTypeEdit->text().trimmed().isEmpty();
-    browseButton->setEnabled(hasRgExe);
-    searchButton->setEnabled(hasRgExe && hasSearchDir && hasFileType && !isSearching);
-    stopButton->setEnabled(isSearching);
+    browseButton->setEnabled(hasRgExe && !isCalibrating);
+    searchButton->setEnabled(hasRgExe && hasSearchDir && hasFileType && !isSearching && !isCalibrating && !isFindingDuplicates);
+    stopButton->setEnabled(isSearching || isCalibrating || isFindingDuplicates);
     exportButton->setEnabled(hasRgExe && hasSearchDir && hasFileType);
+    calibrateButton->setEnabled(hasRgExe && hasSearchDir && hasFileType && !isSearching && !isCalibrating);
+    watchButton->setEnabled(watchThread || (hasRgExe && !lastSearchPath.isEmpty() && !isSearching && !isCalibrating));
+    duplicateButton->setEnabled(resultTable->rowCount() > 1 && !isSearching && !isCalibrating && !isFindingDuplicates);
 }
 
 bool MainWindow::checkRgExe(bool showWarning)
@@ -311,20 +416,106 @@ void MainWindow::onSearchClicked()
 
 void MainWindow::startSearch()
 {
+    stopWatch();
     if (searchThread) {
-        searchWorker->stop();
+        if (searchWorker) {
+            disconnect(searchWorker, nullptr, this, nullptr);
+            searchWorker->stop();
+        }
+        if (archiveWorker) {
+            disconnect(archiveWorker, nullptr, this, nullptr);
+            archiveWorker->stop();
+        }
         searchThread->quit();
         searchThread->wait();
         delete searchThread;
+        searchThread = nullptr;
+        searchWorker = nullptr;
+        archiveWorker = nullptr;
+    }
+
+    if (archiveCheck->isChecked()) {
+        startArchiveSearch();
+        return;
     }
 
     searchWorker = new SearchWorker;
+    searchWorker->setUseDaemon(useDaemonCheck->isChecked());
     searchThread = new QThread(this);
     searchWorker->moveToThread(searchThread);
     connect(searchThread, &QThread::finished, searchWorker, &QObject::deleteLater);
     connect(searchWorker, &SearchWorker::resultFound, this, &MainWindow::onSearchResult);
     connect(searchWorker, &SearchWorker::finished, this, &MainWindow::onSearchFinished);
+    connect(searchWorker, &SearchWorker::warning, this, [this](const QString &message) {
+        writeLog("[后台服务] " + message);
+        statusBarWidget->showMessage(message, 5000);
+    });
+
+    QStringList arguments = buildSearchArguments();
+    arguments << ioTuningArguments();
+    arguments << currentPath;
+
+    writeLog(QString("[startSearch] rgExePath: %1, arguments: %2").arg(rgExePath, arguments.join(" ")));
+    cmdDisplayEdit->setText(rgExePath + " " + arguments.join(" "));
+    writeLog(QString("[搜索] %1").arg(cmdDisplayEdit->text()));
+
+    lastSearchPath = currentPath;
+    lastSearchText = searchEdit->text();
+    lastFixedString = fixedStringRadio->isChecked();
+    lastGlobArguments.clear();
+    for (const QString &argument : std::as_const(arguments)) {
+        if (argument.startsWith("--glob=")) {
+            lastGlobArguments << argument;
+        }
+    }
+
+    resultTable->setRowCount(0);
+    searchThread->start();
+    QMetaObject::invokeMethod(searchWorker, "start", Qt::QueuedConnection,
+                              Q_ARG(QString, rgExePath),
+                              Q_ARG(QStringList, arguments));
+    
+    isSearching = true;
+    updateButtonsState();
+    statusBarWidget->showMessage("搜索中，请等待...");
+}
+
+void MainWindow::startArchiveSearch()
+{
+    archiveWorker = new ArchiveWorker;
+    searchThread = new QThread(this);
+    archiveWorker->moveToThread(searchThread);
+    connect(searchThread, &QThread::finished, archiveWorker, &QObject::deleteLater);
+    connect(archiveWorker, &ArchiveWorker::resultFound, this, &MainWindow::onSearchResult);
+    connect(archiveWorker, &ArchiveWorker::finished, this, &MainWindow::onSearchFinished);
+    connect(archiveWorker, &ArchiveWorker::warning, this, [this](const QString &message) {
+        writeLog("[压缩包搜索] " + message);
+    });
+
+    QString searchText = searchEdit->text();
+    QStringList patterns = fileTypeEdit->text().split(';', Qt::SkipEmptyParts);
+    cmdDisplayEdit->setText(QString("[压缩包搜索] %1 内容: %2 过滤: %3")
+                            .arg(currentPath, searchText, fileTypeEdit->text()));
+    writeLog(QString("[搜索] %1").arg(cmdDisplayEdit->text()));
+
+    // 监视模式依赖 rg.exe，不适用于压缩包结果
+    lastSearchPath.clear();
+
+    resultTable->setRowCount(0);
+    searchThread->start();
+    QMetaObject::invokeMethod(archiveWorker, "start", Qt::QueuedConnection,
+                              Q_ARG(QString, currentPath),
+                              Q_ARG(QString, searchText),
+                              Q_ARG(bool, fixedStringRadio->isChecked()),
+                              Q_ARG(QStringList, patterns));
 
+    isSearching = true;
+    updateButtonsState();
+    statusBarWidget->showMessage("正在搜索压缩包，请等待...");
+}
+
+QStringList MainWindow::buildSearchArguments() const
+{
     QStringList arguments;
     QString searchText = searchEdit->text();
     QString fileType = fileTypeEdit->text();
@@ -336,7 +527,8 @@ void MainWindow::startSearch()
         if (fixedStringRadio->isChecked()) {
             arguments << "-F";
         }
-        arguments << searchText;
+        // 经 -e 传入，以 - 开头的搜索内容不会被 rg 当成选项
+        arguments << "-e" << searchText;
     }
     if (!fileType.isEmpty()) {
         QStringList patterns = fileType.split(';', Qt::SkipEmptyParts);
@@ -350,37 +542,381 @@ void MainWindow::startSearch()
     arguments << "--glob=!pagefile.sys";
     arguments << "--glob=!hiberfil.sys";
     arguments << "--glob=!swapfile.sys";
-    arguments << currentPath;
+    return arguments;
+}
 
-    writeLog(QString("[startSearch] rgExePath: %1, arguments: %2").arg(rgExePath, arguments.join(" ")));
-    cmdDisplayEdit->setText(rgExePath + " " + arguments.join(" "));
-    writeLog(QString("[搜索] %1").arg(cmdDisplayEdit->text()));
+QStringList MainWindow::ioTuningArguments()
+{
+    QString mode = ioProfileCombo->currentData().toString();
+    IoProfile profile;
+    if (mode == "default") {
+        return QStringList();
+    } else if (mode == "ssd") {
+        profile = IoTuning::profileForStorage(StorageKind::SolidState);
+    } else if (mode == "hdd") {
+        profile = IoTuning::profileForStorage(StorageKind::Rotational);
+    } else if (mode == "network") {
+        profile = IoTuning::profileForStorage(StorageKind::Network);
+    } else if (calibratedProfiles.contains(currentPath)) {
+        // 自动模式优先使用该目录的校准结果
+        profile = IoProfile::fromJson(calibratedProfiles.value(currentPath));
+    } else if (storageKind != StorageKind::Unknown) {
+        profile = IoTuning::profileForStorage(storageKind);
+    } else {
+        return QStringList();
+    }
+    writeLog(QString("[I/O 配置] %1").arg(profile.describe()));
+    return profile.toArguments();
+}
 
-    resultTable->setRowCount(0);
-    searchThread->start();
-    QMetaObject::invokeMethod(searchWorker, "start", Qt::QueuedConnection,
+void MainWindow::updateStorageInfo()
+{
+    if (currentPath.isEmpty()) {
+        storageKind = StorageKind::Unknown;
+        storageLabel->clear();
+        return;
+    }
+    storageKind = IoTuning::detectStorageKind(currentPath);
+    QString text = "存储类型: " + IoTuning::storageKindName(storageKind);
+    if (calibratedProfiles.contains(currentPath)) {
+        text += "（已校准）";
+    }
+    storageLabel->setText(text);
+}
+
+void MainWindow::onCalibrateClicked()
+{
+    if (!checkRgExe(true) || currentPath.isEmpty()) {
+        return;
+    }
+
+    if (calibrationThread) {
+        calibrationThread->quit();
+        calibrationThread->wait();
+        delete calibrationThread;
+    }
+
+    calibrationWorker = new CalibrationWorker;
+    calibrationThread = new QThread(this);
+    calibrationWorker->moveToThread(calibrationThread);
+    connect(calibrationThread, &QThread::finished, calibrationWorker, &QObject::deleteLater);
+    connect(calibrationWorker, &CalibrationWorker::progress, this, &MainWindow::onCalibrationProgress);
+    connect(calibrationWorker, &CalibrationWorker::finished, this, &MainWindow::onCalibrationFinished);
+
+    QStringList arguments = buildSearchArguments();
+    writeLog(QString("[校准] 开始, 目录: %1, arguments: %2").arg(currentPath, arguments.join(" ")));
+    calibrationThread->start();
+    QMetaObject::invokeMethod(calibrationWorker, "start", Qt::QueuedConnection,
                               Q_ARG(QString, rgExePath),
-                              Q_ARG(QStringList, arguments));
-    
-    isSearching = true;
+                              Q_ARG(QStringList, arguments),
+                              Q_ARG(QString, currentPath));
+
+    isCalibrating = true;
     updateButtonsState();
-    statusBarWidget->showMessage("搜索中，请等待...");
+    statusBarWidget->showMessage("正在校准 I/O 参数，请等待...");
+}
+
+void MainWindow::onCalibrationProgress(int current, int total, const QString &message)
+{
+    statusBarWidget->showMessage(QString("校准中 [%1/%2] %3").arg(current).arg(total).arg(message));
+    writeLog(QString("[校准] [%1/%2] %3").arg(current).arg(total).arg(message));
+}
+
+void MainWindow::onCalibrationFinished(bool success, const QString &rootPath, const QJsonObject &bestProfile)
+{
+    if (calibrationThread) {
+        calibrationThread->quit();
+        calibrationThread->wait();
+        delete calibrationThread;
+        calibrationThread = nullptr;
+        calibrationWorker = nullptr;
+    }
+    isCalibrating = false;
+    updateButtonsState();
+
+    if (!success) {
+        statusBarWidget->showMessage("I/O 校准失败或已取消");
+        writeLog("[校准] 失败或已取消");
+        return;
+    }
+    calibratedProfiles.insert(rootPath, bestProfile);
+    saveConfig();
+    updateStorageInfo();
+    QString desc = IoProfile::fromJson(bestProfile).describe();
+    statusBarWidget->showMessage("校准完成，最佳参数: " + desc);
+    writeLog("[校准] 完成, 最佳参数: " + desc);
+}
+
+void MainWindow::onWatchToggled(bool checked)
+{
+    if (!checked) {
+        stopWatch();
+        updateButtonsState();
+        updateResultCount();
+        return;
+    }
+    if (watchThread) {
+        return;
+    }
+    if (lastSearchPath.isEmpty() || !checkRgExe(true)) {
+        QSignalBlocker blocker(watchButton);
+        watchButton->setChecked(false);
+        return;
+    }
+
+    watchWorker = new WatchWorker;
+    watchThread = new QThread(this);
+    watchWorker->moveToThread(watchThread);
+    connect(watchThread, &QThread::finished, watchWorker, &QObject::deleteLater);
+    connect(watchWorker, &WatchWorker::watchStarted, this, &MainWindow::onWatchStarted);
+    connect(watchWorker, &WatchWorker::resultAdded, this, &MainWindow::onWatchResultAdded);
+    connect(watchWorker, &WatchWorker::resultRemoved, this, &MainWindow::onWatchResultRemoved);
+
+    writeLog(QString("[监视] 开始, 目录: %1").arg(lastSearchPath));
+    statusBarWidget->showMessage("正在建立目录监视，请等待...");
+    watchThread->start();
+    QMetaObject::invokeMethod(watchWorker, "start", Qt::QueuedConnection,
+                              Q_ARG(QString, rgExePath),
+                              Q_ARG(QString, lastSearchPath),
+                              Q_ARG(QString, lastSearchText),
+                              Q_ARG(bool, lastFixedString),
+                              Q_ARG(QStringList, lastGlobArguments));
+    updateButtonsState();
+}
+
+void MainWindow::stopWatch()
+{
+    if (watchThread) {
+        // 先结束正在运行的 rg，工作线程随即回到事件循环；不能阻塞等待整批匹配超时。
+        // QFileSystemWatcher 作为 watchWorker 的子对象，随 deleteLater 在工作线程中释放
+        watchWorker->requestStop();
+        QMetaObject::invokeMethod(watchWorker, "stop", Qt::QueuedConnection);
+        watchThread->quit();
+        if (watchThread->wait(3000)) {
+            delete watchThread;
+        } else {
+            // 仍未退出（如 rg 无法被结束）：不再等待，线程结束后自行释放
+            writeLog("[监视] 工作线程未能及时退出，转为后台释放");
+            watchThread->setParent(nullptr);
+            connect(watchThread, &QThread::finished, watchThread, &QObject::deleteLater);
+        }
+        watchThread = nullptr;
+        watchWorker = nullptr;
+        writeLog("[监视] 已停止");
+    }
+    if (watchButton->isChecked()) {
+        QSignalBlocker blocker(watchButton);
+        watchButton->setChecked(false);
+    }
+}
+
+void MainWindow::onWatchStarted(int directoryCount)
+{
+    writeLog(QString("[监视] 已监视 %1 个目录").arg(directoryCount));
+    statusBarWidget->showMessage(QString("共找到 %1 个结果，监视中（%2 个目录）")
+                                 .arg(resultTable->rowCount()).arg(directoryCount));
+}
+
+int MainWindow::findResultRow(const QString &name, const QString &path) const
+{
+    for (int row = 0; row < resultTable->rowCount(); ++row) {
+        if (resultTable->item(row, 0)->text() == name && resultTable->item(row, 1)->text() == path) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+void MainWindow::onWatchResultAdded(const QString &name, const QString &path)
+{
+    if (findResultRow(name, path) >= 0) {
+        return;
+    }
+    int row = resultTable->rowCount();
+    resultTable->insertRow(row);
+    // 监视期间新增的结果加粗高亮，作为“新”标记
+    QFont font = resultTable->font();
+    font.setBold(true);
+    for (int column = 0; column < 2; ++column) {
+        QTableWidgetItem *item = new QTableWidgetItem(column == 0 ? name : path);
+        item->setFont(font);
+        item->setBackground(QColor(255, 245, 200));
+        item->setToolTip("新增（监视模式）");
+        resultTable->setItem(row, column, item);
+    }
+    resultTable->sortItems(0, Qt::AscendingOrder);
+    updateResultCount();
+    writeLog(QString("[监视] 新增: %1/%2").arg(path, name));
+}
+
+void MainWindow::onWatchResultRemoved(const QString &name, const QString &path)
+{
+    int row = findResultRow(name, path);
+    if (row < 0) {
+        return;
+    }
+    resultTable->removeRow(row);
+    updateResultCount();
+    writeLog(QString("[监视] 移除: %1/%2").arg(path, name));
+}
+
+void MainWindow::onFindDuplicatesClicked()
+{
+    // 收集结果中的本地文件，压缩包内的条目不参与比较
+    QStringList files;
+    for (int row = 0; row < resultTable->rowCount(); ++row) {
+        QTableWidgetItem *nameItem = resultTable->item(row, 0);
+        QTableWidgetItem *pathItem = resultTable->item(row, 1);
+        if (!nameItem || !pathItem || pathItem->text().contains("!/")) {
+            continue;
+        }
+        files << QDir(pathItem->text()).filePath(nameItem->text());
+    }
+    if (files.size() < 2) {
+        statusBarWidget->showMessage("结果中可比较的文件不足两个");
+        return;
+    }
+
+    if (duplicateThread) {
+        duplicateThread->quit();
+        duplicateThread->wait();
+        delete duplicateThread;
+    }
+
+    duplicateWorker = new DuplicateWorker;
+    duplicateThread = new QThread(this);
+    duplicateWorker->moveToThread(duplicateThread);
+    connect(duplicateThread, &QThread::finished, duplicateWorker, &QObject::deleteLater);
+    connect(duplicateWorker, &DuplicateWorker::progress, this, &MainWindow::onDuplicateProgress);
+    connect(duplicateWorker, &DuplicateWorker::finished, this, &MainWindow::onDuplicatesFinished);
+
+    writeLog(QString("[重复文件] 开始, 文件数: %1").arg(files.size()));
+    duplicateThread->start();
+    QMetaObject::invokeMethod(duplicateWorker, "start", Qt::QueuedConnection,
+                              Q_ARG(QStringList, files));
+
+    isFindingDuplicates = true;
+    updateButtonsState();
+    statusBarWidget->showMessage("正在查找重复文件，请等待...");
+}
+
+void MainWindow::onDuplicateProgress(int stage, qint64 done, qint64 total)
+{
+    QString stageName;
+    switch (stage) {
+    case DuplicateWorker::SizeStage:
+        stageName = "按大小分组";
+        break;
+    case DuplicateWorker::PartialHashStage:
+        stageName = "比较首尾 4 KB";
+        break;
+    default:
+        stageName = "完整哈希";
+        break;
+    }
+    statusBarWidget->showMessage(QString("查找重复文件 [%1/3] %2: %3/%4")
+                                     .arg(stage).arg(stageName).arg(done).arg(total));
+}
+
+void MainWindow::onDuplicatesFinished(bool completed, const QList<QStringList> &groups, qint64 bytesRead, qint64 totalBytes)
+{
+    if (duplicateThread) {
+        duplicateThread->quit();
+        duplicateThread->wait();
+        delete duplicateThread;
+        duplicateThread = nullptr;
+        duplicateWorker = nullptr;
+    }
+    isFindingDuplicates = false;
+    updateButtonsState();
+
+    if (!completed) {
+        statusBarWidget->showMessage("查找重复文件已取消");
+        writeLog("[重复文件] 已取消");
+        return;
+    }
+    QString summary = QString("找到 %1 组重复文件，读取 %2 / %3 字节")
+                          .arg(groups.size()).arg(bytesRead).arg(totalBytes);
+    statusBarWidget->showMessage(summary);
+    writeLog("[重复文件] 完成, " + summary);
+    if (groups.isEmpty()) {
+        QMessageBox::information(this, "查找重复文件", "当前结果中没有内容相同的文件。");
+        return;
+    }
+    showDuplicateGroups(groups);
+}
+
+void MainWindow::showDuplicateGroups(const QList<QStringList> &groups)
+{
+    QDialog *dialog = new QDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle(QString("重复文件 (%1 组)").arg(groups.size()));
+    dialog->resize(700, 500);
+
+    QTreeWidget *tree = new QTreeWidget(dialog);
+    tree->setHeaderLabels(QStringList() << "文件" << "大小");
+    tree->header()->setStretchLastSection(false);
+    tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    for (const QStringList &group : groups) {
+        qint64 size = QFileInfo(group.first()).size();
+        QTreeWidgetItem *groupItem = new QTreeWidgetItem(tree);
+        groupItem->setText(0, QString("%1 个相同文件").arg(group.size()));
+        groupItem->setText(1, QString::number(size));
+        for (const QString &file : group) {
+            QTreeWidgetItem *fileItem = new QTreeWidgetItem(groupItem);
+            fileItem->setText(0, QDir::toNativeSeparators(file));
+            fileItem->setData(0, Qt::UserRole, file);
+        }
+        groupItem->setExpanded(true);
+    }
+    // 双击文件打开所在目录
+    connect(tree, &QTreeWidget::itemDoubleClicked, dialog, [](QTreeWidgetItem *item) {
+        QString file = item->data(0, Qt::UserRole).toString();
+        if (!file.isEmpty()) {
+            QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(file).absolutePath()));
+        }
+    });
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Close, dialog);
+    connect(buttons, &QDialogButtonBox::rejected, dialog, &QDialog::close);
+
+    QVBoxLayout *layout = new QVBoxLayout(dialog);
+    layout->addWidget(tree);
+    layout->addWidget(buttons);
+    dialog->show();
 }
 
 void MainWindow::onStopClicked()
 {
+    if (isCalibrating && calibrationWorker) {
+        calibrationWorker->stop();
+        return;
+    }
+    if (isFindingDuplicates && duplicateWorker) {
+        duplicateWorker->stop();
+        return;
+    }
     stopSearch();
 }
 
 void MainWindow::stopSearch()
 {
     if (searchThread && isSearching) {
-        searchWorker->stop();
+        // 停止后工作对象仍可能发出 finished（压缩包搜索会等线程池收尾），不再处理
+        if (searchWorker) {
+            disconnect(searchWorker, nullptr, this, nullptr);
+            searchWorker->stop();
+        }
+        if (archiveWorker) {
+            disconnect(archiveWorker, nullptr, this, nullptr);
+            archiveWorker->stop();
+        }
         searchThread->quit();
         searchThread->wait();
         delete searchThread;
         searchThread = nullptr;
         searchWorker = nullptr;
+        archiveWorker = nullptr;
         isSearching = false;
         updateButtonsState();
         updateResultCount();
@@ -390,6 +926,10 @@ void MainWindow::stopSearch()
 
 void MainWindow::onSearchFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
+    // 已停止或已被新搜索替换的工作对象发来的通知（断开连接前已排队）
+    if (sender() != searchWorker && sender() != archiveWorker) {
+        return;
+    }
     writeLog(QString("[onSearchFinished] exitCode: %1, exitStatus: %2").arg(exitCode).arg(exitStatus));
     isSearching = false;
     if (searchThread) {
@@ -398,6 +938,7 @@ void MainWindow::onSearchFinished(int exitCode, QProcess::ExitStatus exitStatus)
         delete searchThread;
         searchThread = nullptr;
         searchWorker = nullptr;
+        archiveWorker = nullptr;
     }
     updateButtonsState();
     if (exitStatus == QProcess::NormalExit) {
@@ -419,11 +960,10 @@ void MainWindow::onSearchFinished(int exitCode, QProcess::ExitStatus exitStatus)
 
 void MainWindow::onSearchResult(const QString &name, const QString &path)
 {
-    int row = resultTable->rowCount();
-    resultTable->insertRow(row);
-    resultTable->setItem(row, 0, new QTableWidgetItem(name));
-    resultTable->setItem(row, 1, new QTableWidgetItem(path));
-    resultTable->sortItems(0, Qt::AscendingOrder);
+    if (sender() != searchWorker && sender() != archiveWorker) {
+        return;
+    }
+    ResultTable::appendRow(resultTable, name, path);
     updateResultCount();
 }
 
@@ -445,30 +985,8 @@ void MainWindow::onExportClicked()
         "文本文件 (*.txt);;CSV文件 (*.csv)");
 
     if (!fileName.isEmpty()) {
-        QStringList arguments;
-        QString searchText = searchEdit->text();
-        QString fileType = fileTypeEdit->text();
-        if (searchText.isEmpty()) {
-            arguments << "--files";
-        } else {
-            arguments << "-l";
-            if (fixedStringRadio->isChecked()) {
-                arguments << "-F";
-            }
-            arguments << searchText;
-        }
-        if (!fileType.isEmpty()) {
-            QStringList patterns = fileType.split(';', Qt::SkipEmptyParts);
-            for (const QString &pat : patterns) {
-                arguments << "--glob=" + pat.trimmed();
-            }
-        }
-        arguments << "--no-messages";
-        arguments << "--glob=!System Volume Information/**";
-        arguments << "--glob=!$RECYCLE.BIN/**";
-        arguments << "--glob=!pagefile.sys";
-        arguments << "--glob=!hiberfil.sys";
-        arguments << "--glob=!swapfile.sys";
+        QStringList arguments = buildSearchArguments();
+        arguments << ioTuningArguments();
         arguments << currentPath;
 
         if (exportThread) {
@@ -508,7 +1026,11 @@ void MainWindow::addResultRow(const QString &fullPath)
 void MainWindow::updateResultCount()
 {
     int count = resultTable->rowCount();
-    statusBarWidget->showMessage(QString("共找到 %1 个结果").arg(count));
+    if (watchThread) {
+        statusBarWidget->showMessage(QString("共找到 %1 个结果，监视中").arg(count));
+    } else {
+        statusBarWidget->showMessage(QString("共找到 %1 个结果").arg(count));
+    }
 }
 
 void MainWindow::onResultTableContextMenuRequested(const QPoint &pos)
@@ -524,6 +1046,11 @@ void MainWindow::onOpenPathAction()
     int row = resultTable->currentRow();
     if (row >= 0) {
         QString filePath = resultTable->item(row, 1)->text();
+        // 压缩包内的结果打开压缩包所在目录
+        int archiveSep = filePath.indexOf("!/");
+        if (archiveSep >= 0) {
+            filePath = QFileInfo(filePath.left(archiveSep)).absolutePath();
+        }
         QDesktopServices::openUrl(QUrl::fromLocalFile(filePath));
     }
     updateResultCount();
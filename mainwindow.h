@@ -10,6 +10,11 @@
 #include <QThread>
 #include "searchworker.h"
 #include "exportworker.h"
+#include "calibrationworker.h"
+#include "watchworker.h"
+#include "archiveworker.h"
+#include "duplicateworker.h"
+#include "iotuning.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QFile>
@@ -18,6 +23,11 @@
 #include <QTableWidget>
 #include <QStatusBar>
 #include <QMenu>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QLabel>
+#include <QJsonObject>
+#include <QMap>
 
 class MainWindow : public QMainWindow
 {
@@ -39,10 +49,21 @@ private slots:
     void onResultTableContextMenuRequested(const QPoint &pos);
     void onOpenPathAction();
     void onCheckRgVersionClicked();
+    void onCalibrateClicked();
+    void onCalibrationProgress(int current, int total, const QString &message);
+    void onCalibrationFinished(bool success, const QString &rootPath, const QJsonObject &bestProfile);
+    void onWatchToggled(bool checked);
+    void onWatchStarted(int directoryCount);
+    void onWatchResultAdded(const QString &name, const QString &path);
+    void onWatchResultRemoved(const QString &name, const QString &path);
+    void onFindDuplicatesClicked();
+    void onDuplicateProgress(int stage, qint64 done, qint64 total);
+    void onDuplicatesFinished(bool completed, const QList<QStringList> &groups, qint64 bytesRead, qint64 totalBytes);
 
 private:
     void setupUI();
     void startSearch();
+    void startArchiveSearch();
     void stopSearch();
     void updateButtonsState();
     bool checkRgExe(bool showWarning = true);
@@ -51,6 +72,12 @@ private:
     void updateResultCount();
     void loadConfig();
     void saveConfig();
+    QStringList buildSearchArguments() const;
+    QStringList ioTuningArguments();
+    void updateStorageInfo();
+    void stopWatch();
+    int findResultRow(const QString &name, const QString &path) const;
+    void showDuplicateGroups(const QList<QStringList> &groups);
 
     QLineEdit *rgPathEdit;
     QLineEdit *pathEdit;
@@ -58,24 +85,48 @@ private:
     QLineEdit *fileTypeEdit;
     QRadioButton *fixedStringRadio;
     QRadioButton *regexRadio;
+    QCheckBox *archiveCheck;
     QPushButton *browseRgButton;
     QPushButton *browseButton;
     QPushButton *searchButton;
     QPushButton *stopButton;
     QPushButton *exportButton;
     QPushButton *checkRgVersionButton;
+    QPushButton *watchButton;
+    QPushButton *duplicateButton;
     QTableWidget *resultTable;
     QStatusBar *statusBarWidget;
     QMenu *resultTableMenu;
     QLineEdit *cmdDisplayEdit;
+    QComboBox *ioProfileCombo;
+    QPushButton *calibrateButton;
+    QLabel *storageLabel;
+    QCheckBox *useDaemonCheck;
 
     QThread *searchThread = nullptr;
     SearchWorker *searchWorker = nullptr;
+    ArchiveWorker *archiveWorker = nullptr;   // 压缩包搜索模式下与 searchWorker 共用 searchThread
     QThread *exportThread = nullptr;
     ExportWorker *exportWorker = nullptr;
+    QThread *calibrationThread = nullptr;
+    CalibrationWorker *calibrationWorker = nullptr;
+    QThread *watchThread = nullptr;
+    WatchWorker *watchWorker = nullptr;
+    QThread *duplicateThread = nullptr;
+    DuplicateWorker *duplicateWorker = nullptr;
     QString currentPath;
     QString rgExePath;
     bool isSearching;
+    bool isCalibrating = false;
+    bool isFindingDuplicates = false;
+    StorageKind storageKind = StorageKind::Unknown;
+    QMap<QString, QJsonObject> calibratedProfiles; // 搜索目录 -> 校准得到的最佳 I/O 参数
+
+    // 最近一次搜索的条件，监视模式据此重新匹配变化的文件
+    QString lastSearchPath;
+    QString lastSearchText;
+    bool lastFixedString = true;
+    QStringList lastGlobArguments;   // 首次搜索的 --glob=... 参数
 
     QFile logFile;
     QTextStream logStream;
@@ -0,0 +1,12 @@
+#include "resulttable.h"
+#include <QTableWidget>
+#include <QTableWidgetItem>
+
+void ResultTable::appendRow(QTableWidget *table, const QString &name, const QString &path)
+{
+    int row = table->rowCount();
+    table->insertRow(row);
+    table->setItem(row, 0, new QTableWidgetItem(name));
+    table->setItem(row, 1, new QTableWidgetItem(path));
+    table->sortItems(0, Qt::AscendingOrder);
+}
@@ -0,0 +1,16 @@
+#ifndef RESULTTABLE_H
+#define RESULTTABLE_H
+
+#include <QString>
+
+class QTableWidget;
+
+// 结果表格的行操作，主窗口和性能测试（bench/perfbench）共用，保证测到的是同一份代码
+class ResultTable
+{
+public:
+    // 追加一行搜索结果（名称、所在目录）并按名称重新排序
+    static void appendRow(QTableWidget *table, const QString &name, const QString &path);
+};
+
+#endif // RESULTTABLE_H
@@ -0,0 +1,364 @@
+#include "searchdaemon.h"
+#include "daemonprotocol.h"
+#include "searchworker.h"
+#include <QThread>
+#include <QDataStream>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+static const int kFlushIntervalMs = 50;
+static const int kCacheTtlMs = 30 * 1000;       // 完成的结果缓存 30 秒，供重复搜索直接返回
+static const int kMaxCachedSearches = 32;
+static const int kIdleExitMs = 30 * 60 * 1000;  // 30 分钟无客户端、无搜索则自动退出
+static const int kRowsPerFrame = 1000;
+
+SearchDaemon::SearchDaemon(QObject *parent) : QObject(parent)
+{
+    maxConcurrent = qMax(2, QThread::idealThreadCount() / 4);
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+    connect(&server, &QLocalServer::newConnection, this, &SearchDaemon::onNewConnection);
+    flushTimer.setInterval(kFlushIntervalMs);
+    connect(&flushTimer, &QTimer::timeout, this, &SearchDaemon::flushResults);
+    idleTimer.setSingleShot(true);
+    idleTimer.setInterval(kIdleExitMs);
+    connect(&idleTimer, &QTimer::timeout, this, &SearchDaemon::onIdleTimeout);
+}
+
+SearchDaemon::~SearchDaemon()
+{
+    for (SharedSearch *search : std::as_const(searches)) {
+        stopSearch(search);
+        delete search;
+    }
+}
+
+bool SearchDaemon::listen()
+{
+    if (server.listen(DaemonProtocol::serverName())) {
+        updateIdleTimer();
+        return true;
+    }
+    if (isRunning()) {
+        return false;
+    }
+    // 上次异常退出残留的套接字文件
+    QLocalServer::removeServer(DaemonProtocol::serverName());
+    if (!server.listen(DaemonProtocol::serverName())) {
+        return false;
+    }
+    updateIdleTimer();
+    return true;
+}
+
+bool SearchDaemon::isRunning()
+{
+    QLocalSocket socket;
+    socket.connectToServer(DaemonProtocol::serverName());
+    return socket.waitForConnected(200) && DaemonProtocol::isTrustedServer(&socket);
+}
+
+bool SearchDaemon::launch()
+{
+    return QProcess::startDetached(QCoreApplication::applicationFilePath(), QStringList() << "--daemon");
+}
+
+QString SearchDaemon::loadRgExePath() const
+{
+    // rg.exe 路径由服务端配置决定，不接受客户端传入，避免服务进程替他人执行任意程序
+    QFile configFile(QCoreApplication::applicationDirPath() + "/config.json");
+    if (configFile.open(QIODevice::ReadOnly)) {
+        QJsonObject obj = QJsonDocument::fromJson(configFile.readAll()).object();
+        QString path = obj["rg_exe_path"].toString();
+        if (QFileInfo::exists(path)) {
+            return path;
+        }
+    }
+    QString local = QCoreApplication::applicationDirPath() + "/rg.exe";
+    return QFileInfo::exists(local) ? local : QString("rg");
+}
+
+void SearchDaemon::onNewConnection()
+{
+    while (QLocalSocket *socket = server.nextPendingConnection()) {
+        buffers.insert(socket, QByteArray());
+        connect(socket, &QLocalSocket::readyRead, this, &SearchDaemon::onClientReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &SearchDaemon::onClientDisconnected);
+    }
+    updateIdleTimer();
+}
+
+void SearchDaemon::onClientReadyRead()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (!socket || !buffers.contains(socket)) {
+        return;
+    }
+    QByteArray &buffer = buffers[socket];
+    buffer.append(socket->readAll());
+    QByteArray payload;
+    DaemonProtocol::FrameResult result;
+    while ((result = DaemonProtocol::takeFrame(buffer, &payload)) == DaemonProtocol::FrameReady) {
+        handleFrame(socket, payload);
+        if (!buffers.contains(socket)) {
+            return;
+        }
+    }
+    if (result == DaemonProtocol::FrameInvalid) {
+        // 长度超限后无法再找到帧边界，只能断开；断开后由 onClientDisconnected 清理
+        socket->abort();
+    }
+}
+
+void SearchDaemon::onClientDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (!socket) {
+        return;
+    }
+    unsubscribe(socket, 0, true);
+    buffers.remove(socket);
+    socket->deleteLater();
+    updateIdleTimer();
+}
+
+void SearchDaemon::handleFrame(QLocalSocket *socket, const QByteArray &payload)
+{
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint8 type = 0;
+    quint32 requestId = 0;
+    in >> type >> requestId;
+    if (in.status() != QDataStream::Ok) {
+        socket->abort();
+        return;
+    }
+
+    if (type == DaemonProtocol::Search) {
+        QStringList arguments;
+        in >> arguments;
+        if (in.status() != QDataStream::Ok || arguments.isEmpty()) {
+            socket->write(DaemonProtocol::encodeError(requestId, "无效的搜索请求"));
+            return;
+        }
+        QString error;
+        if (!DaemonProtocol::validateSearchArguments(arguments, &error)) {
+            socket->write(DaemonProtocol::encodeError(requestId, error));
+            return;
+        }
+        subscribe(socket, requestId, arguments);
+    } else if (type == DaemonProtocol::Cancel) {
+        unsubscribe(socket, requestId, false);
+    }
+}
+
+void SearchDaemon::subscribe(QLocalSocket *socket, quint32 requestId, const QStringList &arguments)
+{
+    evictCache();
+    const QString key = arguments.join(QChar(0x1f));
+    Subscriber subscriber{socket, requestId};
+
+    SharedSearch *search = searches.value(key);
+    if (search && search->done) {
+        // 命中缓存：直接回放全部结果
+        sendRows(subscriber, search, 0, search->names.size());
+        socket->write(DaemonProtocol::encodeFinished(requestId, search->exitCode, search->exitStatus));
+        return;
+    }
+    if (search) {
+        // 相同参数的搜索正在进行：先补发已推送的部分，后续结果随其他订阅者一起推送
+        sendRows(subscriber, search, 0, search->flushed);
+        search->subscribers << subscriber;
+        return;
+    }
+
+    search = new SharedSearch;
+    search->key = key;
+    search->arguments = arguments;
+    search->subscribers << subscriber;
+    searches.insert(key, search);
+    pending << search;
+    startPending();
+}
+
+void SearchDaemon::unsubscribe(QLocalSocket *socket, quint32 requestId, bool allRequests)
+{
+    const QList<SharedSearch *> all = searches.values();
+    for (SharedSearch *search : all) {
+        for (int i = search->subscribers.size() - 1; i >= 0; --i) {
+            const Subscriber &sub = search->subscribers[i];
+            if (sub.socket == socket && (allRequests || sub.requestId == requestId)) {
+                search->subscribers.removeAt(i);
+            }
+        }
+        // 没人再等的未完成搜索直接停掉，不进入缓存
+        if (!search->done && search->subscribers.isEmpty()) {
+            pending.removeAll(search);
+            stopSearch(search);
+            searches.remove(search->key);
+            delete search;
+        }
+    }
+    startPending();
+}
+
+void SearchDaemon::startPending()
+{
+    while (runningCount < maxConcurrent && !pending.isEmpty()) {
+        runSearch(pending.takeFirst());
+    }
+    updateIdleTimer();
+}
+
+void SearchDaemon::runSearch(SharedSearch *search)
+{
+    const QString key = search->key;
+    search->worker = new SearchWorker;
+    search->thread = new QThread(this);
+    search->worker->moveToThread(search->thread);
+    connect(search->thread, &QThread::finished, search->worker, &QObject::deleteLater);
+    connect(search->worker, &SearchWorker::resultFound, this, [this, key](const QString &name, const QString &path) {
+        onSearchResult(key, name, path);
+    });
+    connect(search->worker, &SearchWorker::finished, this, [this, key](int exitCode, QProcess::ExitStatus exitStatus) {
+        onSearchFinished(key, exitCode, exitStatus);
+    });
+
+    ++runningCount;
+    search->thread->start();
+    QMetaObject::invokeMethod(search->worker, "start", Qt::QueuedConnection,
+                              Q_ARG(QString, loadRgExePath()),
+                              Q_ARG(QStringList, search->arguments));
+    if (!flushTimer.isActive()) {
+        flushTimer.start();
+    }
+}
+
+void SearchDaemon::stopSearch(SharedSearch *search)
+{
+    if (!search->thread) {
+        return;
+    }
+    search->worker->stop();
+    search->thread->quit();
+    search->thread->wait();
+    delete search->thread;
+    search->thread = nullptr;
+    search->worker = nullptr;
+    if (!search->done) {
+        --runningCount;
+    }
+}
+
+void SearchDaemon::onSearchResult(const QString &key, const QString &name, const QString &path)
+{
+    SharedSearch *search = searches.value(key);
+    if (!search || search->done) {
+        return;
+    }
+    search->names << name;
+    search->paths << path;
+}
+
+void SearchDaemon::onSearchFinished(const QString &key, int exitCode, QProcess::ExitStatus exitStatus)
+{
+    SharedSearch *search = searches.value(key);
+    if (!search || search->done || !search->thread) {
+        return;
+    }
+    flushResults();
+    search->exitCode = exitCode;
+    search->exitStatus = quint8(exitStatus);
+    for (const Subscriber &sub : std::as_const(search->subscribers)) {
+        sub.socket->write(DaemonProtocol::encodeFinished(sub.requestId, search->exitCode, search->exitStatus));
+    }
+    search->subscribers.clear();
+    stopSearch(search);
+    search->done = true;
+    search->finishedTimer.start();
+
+    // 只缓存正常结束的结果
+    if (exitStatus != QProcess::NormalExit || exitCode > 1) {
+        searches.remove(key);
+        delete search;
+    }
+    evictCache();
+    startPending();
+}
+
+void SearchDaemon::sendRows(const Subscriber &subscriber, const SharedSearch *search, int from, int to)
+{
+    for (int i = from; i < to; i += kRowsPerFrame) {
+        int count = qMin(kRowsPerFrame, to - i);
+        subscriber.socket->write(DaemonProtocol::encodeResults(subscriber.requestId,
+                                                               search->names.mid(i, count),
+                                                               search->paths.mid(i, count)));
+    }
+}
+
+void SearchDaemon::flushResults()
+{
+    bool anyRunning = false;
+    for (SharedSearch *search : std::as_const(searches)) {
+        if (search->done) {
+            continue;
+        }
+        anyRunning = true;
+        int total = search->names.size();
+        if (search->flushed == total) {
+            continue;
+        }
+        for (const Subscriber &sub : std::as_const(search->subscribers)) {
+            sendRows(sub, search, search->flushed, total);
+        }
+        search->flushed = total;
+    }
+    if (!anyRunning) {
+        flushTimer.stop();
+    }
+}
+
+void SearchDaemon::evictCache()
+{
+    QList<SharedSearch *> cached;
+    for (auto it = searches.begin(); it != searches.end();) {
+        SharedSearch *search = it.value();
+        if (search->done && search->finishedTimer.elapsed() > kCacheTtlMs) {
+            delete search;
+            it = searches.erase(it);
+        } else {
+            if (search->done) {
+                cached << search;
+            }
+            ++it;
+        }
+    }
+    // 超出上限时先淘汰最早完成的
+    std::sort(cached.begin(), cached.end(), [](const SharedSearch *a, const SharedSearch *b) {
+        return a->finishedTimer.elapsed() > b->finishedTimer.elapsed();
+    });
+    while (cached.size() > kMaxCachedSearches) {
+        SharedSearch *search = cached.takeFirst();
+        searches.remove(search->key);
+        delete search;
+    }
+}
+
+void SearchDaemon::updateIdleTimer()
+{
+    if (buffers.isEmpty() && runningCount == 0 && pending.isEmpty()) {
+        if (!idleTimer.isActive()) {
+            idleTimer.start();
+        }
+    } else {
+        idleTimer.stop();
+    }
+}
+
+void SearchDaemon::onIdleTimeout()
+{
+    QCoreApplication::quit();
+}
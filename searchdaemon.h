@@ -0,0 +1,80 @@
+#ifndef SEARCHDAEMON_H
+#define SEARCHDAEMON_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QProcess>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class QThread;
+class SearchWorker;
+
+// 后台搜索服务：多个客户端共享同一组 rg.exe 进程和结果缓存，结果增量推送
+class SearchDaemon : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SearchDaemon(QObject *parent = nullptr);
+    ~SearchDaemon();
+
+    bool listen();
+
+    static bool isRunning();
+    static bool launch();
+
+private slots:
+    void onNewConnection();
+    void onClientReadyRead();
+    void onClientDisconnected();
+    void flushResults();
+    void onIdleTimeout();
+
+private:
+    struct Subscriber {
+        QLocalSocket *socket;
+        quint32 requestId;
+    };
+
+    struct SharedSearch {
+        QString key;
+        QStringList arguments;
+        QThread *thread = nullptr;
+        SearchWorker *worker = nullptr;
+        QStringList names;
+        QStringList paths;
+        int flushed = 0;          // 已推送给现有订阅者的行数
+        bool done = false;
+        qint32 exitCode = 0;
+        quint8 exitStatus = 0;
+        QList<Subscriber> subscribers;
+        QElapsedTimer finishedTimer;
+    };
+
+    void handleFrame(QLocalSocket *socket, const QByteArray &payload);
+    void subscribe(QLocalSocket *socket, quint32 requestId, const QStringList &arguments);
+    void unsubscribe(QLocalSocket *socket, quint32 requestId, bool allRequests);
+    void startPending();
+    void runSearch(SharedSearch *search);
+    void stopSearch(SharedSearch *search);
+    void onSearchResult(const QString &key, const QString &name, const QString &path);
+    void onSearchFinished(const QString &key, int exitCode, QProcess::ExitStatus exitStatus);
+    void sendRows(const Subscriber &subscriber, const SharedSearch *search, int from, int to);
+    void evictCache();
+    void updateIdleTimer();
+    QString loadRgExePath() const;
+
+    QLocalServer server;
+    QHash<QString, SharedSearch *> searches;   // 参数 -> 搜索（运行中、排队中或已缓存）
+    QList<SharedSearch *> pending;
+    QHash<QLocalSocket *, QByteArray> buffers;
+    QTimer flushTimer;
+    QTimer idleTimer;
+    int runningCount = 0;
+    int maxConcurrent = 2;
+};
+
+#endif // SEARCHDAEMON_H
@@ -1,5 +1,8 @@
 #include "searchworker.h"
+#include "daemonprotocol.h"
 #include <QFileInfo>
+#include <QLocalSocket>
+#include <QDataStream>
 
 SearchWorker::SearchWorker(QObject *parent) : QObject(parent)
 {
@@ -9,18 +12,121 @@ SearchWorker::SearchWorker(QObject *parent) : QObject(parent)
 }
 
 void SearchWorker::start(const QString &rgExePath, const QStringList &arguments)
+{
+    stopRequested = false;
+    rgExe = rgExePath;
+    searchArguments = arguments;
+    if (useDaemon && startRemote(arguments)) {
+        return;
+    }
+    startLocal();
+}
+
+void SearchWorker::startLocal()
 {
     process.setProcessChannelMode(QProcess::MergedChannels);
-    process.start(rgExePath, arguments);
+    process.start(rgExe, searchArguments);
+}
+
+void SearchWorker::abandonRemote()
+{
+    remoteFinished = true;
+    socketBuffer.clear();
+    socket->abort();
+    socket->deleteLater();
+    socket = nullptr;
+    if (stopRequested) {
+        return;
+    }
+    if (remoteResultsSeen) {
+        // 已经显示了部分结果，重新搜索会产生重复行
+        emit finished(2, QProcess::CrashExit);
+        return;
+    }
+    emit warning("改用本地 rg.exe 搜索");
+    startLocal();
 }
 
 void SearchWorker::stop()
 {
+    // 远程搜索随 socket 销毁而断开，服务端会取消没有订阅者的搜索
+    stopRequested = true;
     if (process.state() != QProcess::NotRunning) {
         process.kill();
     }
 }
 
+bool SearchWorker::startRemote(const QStringList &arguments)
+{
+    socket = new QLocalSocket(this);
+    socket->connectToServer(DaemonProtocol::serverName());
+    if (!socket->waitForConnected(500) || !DaemonProtocol::isTrustedServer(socket)) {
+        delete socket;
+        socket = nullptr;
+        return false;
+    }
+    connect(socket, &QLocalSocket::readyRead, this, &SearchWorker::onSocketReadyRead);
+    connect(socket, &QLocalSocket::disconnected, this, &SearchWorker::onSocketDisconnected);
+    remoteFinished = false;
+    remoteResultsSeen = false;
+    ++requestId;
+    socket->write(DaemonProtocol::encodeSearch(requestId, arguments));
+    return true;
+}
+
+void SearchWorker::onSocketReadyRead()
+{
+    socketBuffer.append(socket->readAll());
+    QByteArray payload;
+    DaemonProtocol::FrameResult result = DaemonProtocol::FrameIncomplete;
+    while (!remoteFinished
+           && (result = DaemonProtocol::takeFrame(socketBuffer, &payload)) == DaemonProtocol::FrameReady) {
+        QDataStream in(payload);
+        in.setVersion(QDataStream::Qt_6_0);
+        quint8 type = 0;
+        quint32 id = 0;
+        in >> type >> id;
+        if (id != requestId) {
+            continue;
+        }
+        if (type == DaemonProtocol::Results) {
+            QStringList names;
+            QStringList paths;
+            in >> names >> paths;
+            remoteResultsSeen = remoteResultsSeen || !names.isEmpty();
+            for (int i = 0; i < names.size() && i < paths.size(); ++i) {
+                emit resultFound(names[i], paths[i]);
+            }
+        } else if (type == DaemonProtocol::Finished) {
+            qint32 exitCode = 0;
+            quint8 exitStatus = 0;
+            in >> exitCode >> exitStatus;
+            remoteFinished = true;
+            socket->disconnectFromServer();
+            emit finished(exitCode, QProcess::ExitStatus(exitStatus));
+        } else if (type == DaemonProtocol::Error) {
+            QString message;
+            in >> message;
+            emit warning("后台服务拒绝了搜索请求: " + message);
+            abandonRemote();
+            return;
+        }
+    }
+    if (result == DaemonProtocol::FrameInvalid) {
+        emit warning("后台服务返回了非法数据帧");
+        abandonRemote();
+    }
+}
+
+void SearchWorker::onSocketDisconnected()
+{
+    // 服务异常退出，按进程崩溃处理
+    if (!remoteFinished && !stopRequested) {
+        remoteFinished = true;
+        emit finished(2, QProcess::CrashExit);
+    }
+}
+
 void SearchWorker::onReadyRead()
 {
     QString output = QString::fromUtf8(process.readAllStandardOutput());
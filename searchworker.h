@@ -3,6 +3,10 @@
 
 #include <QObject>
 #include <QProcess>
+#include <QByteArray>
+#include <atomic>
+
+class QLocalSocket;
 
 class SearchWorker : public QObject
 {
@@ -10,6 +14,9 @@ class SearchWorker : public QObject
 public:
     explicit SearchWorker(QObject *parent = nullptr);
 
+    // 优先把搜索交给后台服务，连接不上时退回本地 rg.exe
+    void setUseDaemon(bool enabled) { useDaemon = enabled; }
+
 public slots:
     void start(const QString &rgExePath, const QStringList &arguments);
     void stop();
@@ -17,12 +24,30 @@ public slots:
 signals:
     void resultFound(const QString &name, const QString &path);
     void finished(int exitCode, QProcess::ExitStatus exitStatus);
+    // 后台服务报错或连接异常等不影响搜索继续进行的提示
+    void warning(const QString &message);
 
 private slots:
     void onReadyRead();
+    void onSocketReadyRead();
+    void onSocketDisconnected();
 
 private:
+    bool startRemote(const QStringList &arguments);
+    void startLocal();
+    // 与服务的连接无法继续使用时断开，尚未收到结果则改用本地 rg.exe 重新搜索
+    void abandonRemote();
+
     QProcess process;
+    QString rgExe;
+    QStringList searchArguments;
+    bool useDaemon = false;
+    QLocalSocket *socket = nullptr;
+    QByteArray socketBuffer;
+    quint32 requestId = 0;
+    bool remoteFinished = false;
+    bool remoteResultsSeen = false;
+    std::atomic<bool> stopRequested{false};
 };
 
 #endif // SEARCHWORKER_H
@@ -0,0 +1,18 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_archivestream
+TEMPLATE = app
+DESTDIR = $$OUT_PWD/../bin
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_archivestream.cpp \
+    ../../archivestream.cpp
+
+HEADERS += \
+    ../../archivestream.h
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# 生成 tst_archivestream 使用的参考数据，压缩/打包均由 zlib、gzip、tarfile 完成。
+# 输出是确定的（固定随机种子和时间戳），重新生成后不应产生差异。
+import gzip
+import io
+import os
+import random
+import tarfile
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+MTIME = 1700000000
+
+
+def write(name, data):
+    with open(os.path.join(HERE, name), "wb") as f:
+        f.write(data)
+
+
+def raw_deflate(data, level=9, strategy=zlib.Z_DEFAULT_STRATEGY):
+    c = zlib.compressobj(level, zlib.DEFLATED, -15, 9, strategy)
+    return c.compress(data) + c.flush()
+
+
+def gzip_member(data, name=None, comment=None, extra=None, hcrc=False):
+    # 手工拼 gzip 头，以覆盖 FEXTRA/FNAME/FCOMMENT/FHCRC 各个可选字段
+    flags = 0
+    tail = b""
+    if extra is not None:
+        flags |= 0x04
+        tail += len(extra).to_bytes(2, "little") + extra
+    if name is not None:
+        flags |= 0x08
+        tail += name + b"\0"
+    if comment is not None:
+        flags |= 0x10
+        tail += comment + b"\0"
+    header = bytes([0x1F, 0x8B, 8, flags | (0x02 if hcrc else 0)]) + MTIME.to_bytes(4, "little") + bytes([0, 255])
+    header += tail
+    if hcrc:
+        header += (zlib.crc32(header) & 0xFFFF).to_bytes(2, "little")
+    return (header + raw_deflate(data)
+            + (zlib.crc32(data) & 0xFFFFFFFF).to_bytes(4, "little")
+            + (len(data) & 0xFFFFFFFF).to_bytes(4, "little"))
+
+
+def plain_data():
+    rng = random.Random(20240229)
+    out = bytearray()
+    for i in range(400):
+        out += ("搜索结果 SearchEverything 压缩包测试 line %d\n" % i).encode()
+    # 随机块重复出现，回溯距离接近 32 KB 窗口上限
+    block = bytes(rng.getrandbits(8) for _ in range(30000))
+    out += block + b"--" + block
+    # 长串重复字节，覆盖最大匹配长度 258
+    out += b"z" * 5000
+    return bytes(out)
+
+
+def add_file(tar, name, data):
+    info = tarfile.TarInfo(name)
+    info.size = len(data)
+    info.mtime = MTIME
+    tar.addfile(info, io.BytesIO(data))
+
+
+def add_dir(tar, name):
+    info = tarfile.TarInfo(name)
+    info.type = tarfile.DIRTYPE
+    info.mtime = MTIME
+    tar.addfile(info)
+
+
+def add_symlink(tar, name, target):
+    info = tarfile.TarInfo(name)
+    info.type = tarfile.SYMTYPE
+    info.linkname = target
+    info.mtime = MTIME
+    tar.addfile(info)
+
+
+def make_tar(fmt, build):
+    buf = io.BytesIO()
+    with tarfile.open(fileobj=buf, mode="w", format=fmt) as tar:
+        build(tar)
+    return buf.getvalue()
+
+
+def main():
+    plain = plain_data()
+    write("plain.bin", plain)
+    write("stored.deflate", raw_deflate(plain, level=0))
+    write("fixed.deflate", raw_deflate(plain, strategy=zlib.Z_FIXED))
+    write("dynamic.deflate", raw_deflate(plain))
+    write("empty.deflate", raw_deflate(b""))
+
+    first = plain[:20000]
+    second = "第二个成员\n".encode() * 100
+    write("multi.gz", gzip_member(first) + gzip_member(second, name=b"b.txt", comment=b"c",
+                                                         extra=b"SE\x02\x00hi", hcrc=True))
+    write("multi.expected", first + second)
+
+    long_dir = "长目录" * 20                      # 180 字节，超出 ustar 的 100 字节 name 字段
+    long_name = "long_" + "n" * 120 + ".txt"
+
+    def ustar(tar):
+        add_file(tar, "top.txt", b"top\n")
+        add_file(tar, "prefix/" + "p" * 90 + "/file.txt", b"prefix\n")
+        add_file(tar, "empty.txt", b"")
+
+    def gnu(tar):
+        add_file(tar, long_name, b"gnu long\n")
+        add_dir(tar, long_dir)
+        add_file(tar, "after_dir.txt", b"after dir\n")
+        add_symlink(tar, "link", "t" * 150)
+        add_symlink(tar, "s" * 120, "short")
+        add_file(tar, "after_link.txt", b"after link\n")
+
+    def pax(tar):
+        add_file(tar, long_dir + "/文件.txt", "pax 中文\n".encode())
+        add_dir(tar, "d" * 120)
+        add_file(tar, "after_dir.txt", b"after dir\n")
+        add_file(tar, "x" * 200 + ".log", b"pax long\n")
+
+    write("ustar.tar", make_tar(tarfile.USTAR_FORMAT, ustar))
+    write("gnu.tar", make_tar(tarfile.GNU_FORMAT, gnu))
+    write("pax.tar", make_tar(tarfile.PAX_FORMAT, pax))
+    write("gnu.tar.gz", gzip_member(make_tar(tarfile.GNU_FORMAT, gnu)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,209 @@
+#include "archivestream.h"
+#include <QtTest>
+#include <QBuffer>
+#include <QFile>
+#include <QList>
+#include <QPair>
+
+// 参考数据见 data/generate.py：deflate/gzip 由 zlib 生成，tar 由 Python tarfile 生成
+class TestArchiveStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void inflate_data();
+    void inflate();
+    void inflateTruncated();
+    void inflateAborted();
+    void gunzipMultiMember();
+    void gunzipTarball();
+    void tar_data();
+    void tar();
+
+private:
+    static QByteArray readData(const QString &name);
+    static StreamResult inflateBytes(const QByteArray &compressed, QByteArray *output);
+    // 以固定大小分块推入，使头部和数据跨越多次 feed
+    static QList<QPair<QString, QByteArray>> parseTar(const QByteArray &archive, int chunkSize, bool *ok);
+};
+
+using TarEntries = QList<QPair<QString, QByteArray>>;
+
+QByteArray TestArchiveStream::readData(const QString &name)
+{
+    const QString path = QFINDTESTDATA("data/" + name);
+    QFile file(path);
+    if (path.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+        qWarning("缺少测试数据: %s", qPrintable(name));
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+StreamResult TestArchiveStream::inflateBytes(const QByteArray &compressed, QByteArray *output)
+{
+    QBuffer buffer;
+    buffer.setData(compressed);
+    buffer.open(QIODevice::ReadOnly);
+    ByteSource source(&buffer);
+    return inflateRaw(source, [output](const char *data, qint64 size) {
+        output->append(data, size);
+        return true;
+    });
+}
+
+TarEntries TestArchiveStream::parseTar(const QByteArray &archive, int chunkSize, bool *ok)
+{
+    TarEntries entries;
+    bool ended = true;
+    TarParser parser([&entries, &ended](const QString &path, qint64 size) -> ChunkSink {
+        Q_UNUSED(size);
+        entries << qMakePair(path, QByteArray());
+        ended = false;
+        return [&entries, &ended](const char *data, qint64 length) {
+            if (data) {
+                entries.last().second.append(data, length);
+            } else {
+                ended = true;
+            }
+            return true;
+        };
+    });
+    *ok = true;
+    for (qint64 offset = 0; offset < archive.size() && *ok; offset += chunkSize) {
+        *ok = parser.feed(archive.constData() + offset, qMin<qint64>(chunkSize, archive.size() - offset));
+    }
+    *ok = *ok && parser.finished() && ended;
+    return entries;
+}
+
+void TestArchiveStream::inflate_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("stored") << "stored.deflate" << "plain.bin";
+    QTest::newRow("fixed") << "fixed.deflate" << "plain.bin";
+    QTest::newRow("dynamic") << "dynamic.deflate" << "plain.bin";
+    QTest::newRow("empty") << "empty.deflate" << "";
+}
+
+void TestArchiveStream::inflate()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, expected);
+
+    QByteArray output;
+    QCOMPARE(inflateBytes(readData(file), &output), StreamResult::Ok);
+    QByteArray reference = expected.isEmpty() ? QByteArray() : readData(expected);
+    QCOMPARE(output.size(), reference.size());
+    QVERIFY(output == reference);
+}
+
+void TestArchiveStream::inflateTruncated()
+{
+    QByteArray compressed = readData("dynamic.deflate");
+    QVERIFY(!compressed.isEmpty());
+    QByteArray output;
+    QCOMPARE(inflateBytes(compressed.left(compressed.size() / 2), &output), StreamResult::DataError);
+}
+
+void TestArchiveStream::inflateAborted()
+{
+    QBuffer buffer;
+    buffer.setData(readData("dynamic.deflate"));
+    buffer.open(QIODevice::ReadOnly);
+    ByteSource source(&buffer);
+    int calls = 0;
+    StreamResult result = inflateRaw(source, [&calls](const char *, qint64) {
+        ++calls;
+        return false;
+    });
+    QCOMPARE(result, StreamResult::Aborted);
+    QCOMPARE(calls, 1);
+}
+
+void TestArchiveStream::gunzipMultiMember()
+{
+    // 第二个成员带 FEXTRA/FNAME/FCOMMENT/FHCRC
+    QBuffer buffer;
+    buffer.setData(readData("multi.gz"));
+    buffer.open(QIODevice::ReadOnly);
+    ByteSource source(&buffer);
+    QByteArray output;
+    QCOMPARE(gunzip(source, [&output](const char *data, qint64 size) {
+                 output.append(data, size);
+                 return true;
+             }),
+             StreamResult::Ok);
+    QByteArray reference = readData("multi.expected");
+    QCOMPARE(output.size(), reference.size());
+    QVERIFY(output == reference);
+}
+
+void TestArchiveStream::gunzipTarball()
+{
+    QBuffer buffer;
+    buffer.setData(readData("gnu.tar.gz"));
+    buffer.open(QIODevice::ReadOnly);
+    ByteSource source(&buffer);
+    QByteArray tar;
+    QCOMPARE(gunzip(source, [&tar](const char *data, qint64 size) {
+                 tar.append(data, size);
+                 return true;
+             }),
+             StreamResult::Ok);
+    QVERIFY(tar == readData("gnu.tar"));
+}
+
+void TestArchiveStream::tar_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<TarEntries>("expected");
+
+    const QString longDir = QString("长目录").repeated(20);
+
+    TarEntries ustar;
+    ustar << qMakePair(QString("top.txt"), QByteArray("top\n"))
+          << qMakePair("prefix/" + QString(90, 'p') + "/file.txt", QByteArray("prefix\n"))
+          << qMakePair(QString("empty.txt"), QByteArray());
+
+    // 长名目录、长链接目标之后的短名文件不能沿用上一个长文件名
+    TarEntries gnu;
+    gnu << qMakePair("long_" + QString(120, 'n') + ".txt", QByteArray("gnu long\n"))
+        << qMakePair(QString("after_dir.txt"), QByteArray("after dir\n"))
+        << qMakePair(QString("after_link.txt"), QByteArray("after link\n"));
+
+    TarEntries pax;
+    pax << qMakePair(longDir + "/文件.txt", QString("pax 中文\n").toUtf8())
+        << qMakePair(QString("after_dir.txt"), QByteArray("after dir\n"))
+        << qMakePair(QString(200, 'x') + ".log", QByteArray("pax long\n"));
+
+    for (int chunkSize : { 1, 511, 4096, 1 << 20 }) {
+        QTest::addRow("ustar/%d", chunkSize) << "ustar.tar" << chunkSize << ustar;
+        QTest::addRow("gnu/%d", chunkSize) << "gnu.tar" << chunkSize << gnu;
+        QTest::addRow("pax/%d", chunkSize) << "pax.tar" << chunkSize << pax;
+    }
+}
+
+void TestArchiveStream::tar()
+{
+    QFETCH(QString, file);
+    QFETCH(int, chunkSize);
+    QFETCH(TarEntries, expected);
+
+    const QByteArray archive = readData(file);
+    QVERIFY(!archive.isEmpty());
+    bool ok = false;
+    const TarEntries entries = parseTar(archive, chunkSize, &ok);
+    QVERIFY(ok);
+    QCOMPARE(entries.size(), expected.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries[i].first, expected[i].first);
+        QCOMPARE(entries[i].second, expected[i].second);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestArchiveStream)
+#include "tst_archivestream.moc"
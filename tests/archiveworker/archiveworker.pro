@@ -0,0 +1,20 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_archiveworker
+TEMPLATE = app
+DESTDIR = $$OUT_PWD/../bin
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_archiveworker.cpp \
+    ../../archiveworker.cpp \
+    ../../archivestream.cpp
+
+HEADERS += \
+    ../../archiveworker.h \
+    ../../archivestream.h
@@ -0,0 +1,81 @@
+#include "archiveworker.h"
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+
+// 过滤条件与普通搜索一致：! 开头的条件排除条目，也排除压缩包本身
+// 压缩包复用 tests/archivestream/data 中的参考数据
+class TestArchiveWorker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void filters_data();
+    void filters();
+
+private:
+    QTemporaryDir dir;
+};
+
+void TestArchiveWorker::initTestCase()
+{
+    QVERIFY(dir.isValid());
+    // logs.tar.gz 内含 long_n...n.txt、after_dir.txt、after_link.txt；notes.txt.gz 解压后为 notes.txt
+    const QString tarball = QFINDTESTDATA("../archivestream/data/gnu.tar.gz");
+    const QString gz = QFINDTESTDATA("../archivestream/data/multi.gz");
+    QVERIFY(!tarball.isEmpty() && !gz.isEmpty());
+    QVERIFY(QFile::copy(tarball, dir.filePath("logs.tar.gz")));
+    QVERIFY(QFile::copy(gz, dir.filePath("notes.txt.gz")));
+}
+
+void TestArchiveWorker::filters_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QStringList>("expected");
+
+    const QString longName = "long_" + QString(120, 'n') + ".txt";
+    QTest::newRow("include")
+        << QStringList{ "*.txt" }
+        << QStringList{ "after_dir.txt", "after_link.txt", longName, "notes.txt" };
+    QTest::newRow("exclude entries")
+        << QStringList{ "*.txt", "!after_*.txt" }
+        << QStringList{ longName, "notes.txt" };
+    QTest::newRow("exclude archives")
+        << QStringList{ "*.txt", "!*.gz" }
+        << QStringList();
+    QTest::newRow("archive matched, entry excluded")
+        << QStringList{ "*.tar.gz", "!after_*" }
+        << QStringList{ longName };
+    QTest::newRow("exclude only")
+        << QStringList{ "!notes.txt.gz" }
+        << QStringList{ "after_dir.txt", "after_link.txt", longName };
+}
+
+void TestArchiveWorker::filters()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QStringList, expected);
+
+    // 结果由线程池中的任务发出，排队送回测试线程后再收集
+    QStringList names;
+    int exitCode = -1;
+    ArchiveWorker worker;
+    connect(&worker, &ArchiveWorker::resultFound, this, [&names](const QString &name, const QString &) {
+        names << name;
+    }, Qt::QueuedConnection);
+    connect(&worker, &ArchiveWorker::finished, this, [&exitCode](int code, QProcess::ExitStatus) {
+        exitCode = code;
+    });
+
+    worker.start(dir.path(), QString(), true, patterns);
+    QCoreApplication::processEvents();
+
+    names.sort();
+    expected.sort();
+    QCOMPARE(names, expected);
+    QCOMPARE(exitCode, expected.isEmpty() ? 1 : 0);
+}
+
+QTEST_GUILESS_MAIN(TestArchiveWorker)
+#include "tst_archiveworker.moc"
@@ -0,0 +1,8 @@
+# 单元测试：qmake && make (nmake) 后运行 bin 目录下的 tst_* 程序
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    archivestream \
+    archiveworker \
+    watchworker \
+    xxhash3
@@ -0,0 +1,159 @@
+#include "watchworker.h"
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QStandardPaths>
+#include <QFile>
+#include <QFileInfo>
+
+// 内容匹配依赖真实的 rg：优先使用环境变量 RG_EXE，否则在 PATH 中查找
+class TestWatchWorker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void appendAddsResult();
+    void rewriteRemovesResult();
+    void newFileAddsResult();
+    void excludedFilesStayOut();
+    void rgFailureKeepsRows();
+
+private:
+    static void writeFile(const QString &path, const QByteArray &data, QIODevice::OpenMode mode);
+
+    QString rgExe;
+};
+
+void TestWatchWorker::initTestCase()
+{
+    rgExe = qEnvironmentVariable("RG_EXE");
+    if (rgExe.isEmpty()) {
+        rgExe = QStandardPaths::findExecutable("rg");
+    }
+    if (rgExe.isEmpty()) {
+        QSKIP("未找到 rg，请设置 RG_EXE 或将 rg 加入 PATH");
+    }
+}
+
+void TestWatchWorker::writeFile(const QString &path, const QByteArray &data, QIODevice::OpenMode mode)
+{
+    QFile file(path);
+    QVERIFY(file.open(mode));
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+}
+
+void TestWatchWorker::appendAddsResult()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString logPath = dir.filePath("app.log");
+    writeFile(logPath, "starting\n", QIODevice::WriteOnly);
+
+    WatchWorker worker;
+    QSignalSpy added(&worker, &WatchWorker::resultAdded);
+    QSignalSpy removed(&worker, &WatchWorker::resultRemoved);
+    worker.start(rgExe, dir.path(), "ERROR", true, QStringList() << "--glob=*.log");
+
+    // 原地追加：目录本身没有新建/删除条目
+    writeFile(logPath, "ERROR disk full\n", QIODevice::WriteOnly | QIODevice::Append);
+
+    QVERIFY(added.wait(5000));
+    QCOMPARE(added.first().at(0).toString(), QString("app.log"));
+    QCOMPARE(added.first().at(1).toString(), QFileInfo(logPath).absolutePath());
+    QCOMPARE(removed.count(), 0);
+    worker.stop();
+}
+
+void TestWatchWorker::rewriteRemovesResult()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString logPath = dir.filePath("app.log");
+    writeFile(logPath, "ERROR disk full\n", QIODevice::WriteOnly);
+
+    WatchWorker worker;
+    QSignalSpy added(&worker, &WatchWorker::resultAdded);
+    QSignalSpy removed(&worker, &WatchWorker::resultRemoved);
+    worker.start(rgExe, dir.path(), "ERROR", true, QStringList() << "--glob=*.log");
+
+    // 原地改写为不再匹配的内容
+    writeFile(logPath, "all good\n", QIODevice::WriteOnly | QIODevice::Truncate);
+
+    QVERIFY(removed.wait(5000));
+    QCOMPARE(removed.first().at(0).toString(), QString("app.log"));
+    QCOMPARE(added.count(), 0);
+
+    // 改写后仍在监视中，再次追加应重新出现
+    writeFile(logPath, "ERROR again\n", QIODevice::WriteOnly | QIODevice::Append);
+    QVERIFY(added.wait(5000));
+    QCOMPARE(added.first().at(0).toString(), QString("app.log"));
+    worker.stop();
+}
+
+void TestWatchWorker::newFileAddsResult()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    WatchWorker worker;
+    QSignalSpy added(&worker, &WatchWorker::resultAdded);
+    worker.start(rgExe, dir.path(), "ERROR", true, QStringList() << "--glob=*.log");
+
+    writeFile(dir.filePath("ignored.txt"), "ERROR\n", QIODevice::WriteOnly);
+    writeFile(dir.filePath("new.log"), "ERROR\n", QIODevice::WriteOnly);
+
+    QVERIFY(added.wait(5000));
+    QCOMPARE(added.count(), 1);
+    QCOMPARE(added.first().at(0).toString(), QString("new.log"));
+    worker.stop();
+}
+
+void TestWatchWorker::excludedFilesStayOut()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    // .ignore 与 .gitignore 规则相同，且不要求目录是 git 仓库
+    writeFile(dir.filePath(".ignore"), "ignored.log\n", QIODevice::WriteOnly);
+    writeFile(dir.filePath("app.log"), "starting\n", QIODevice::WriteOnly);
+    writeFile(dir.filePath("debug.log"), "starting\n", QIODevice::WriteOnly);
+    writeFile(dir.filePath("ignored.log"), "starting\n", QIODevice::WriteOnly);
+
+    WatchWorker worker;
+    QSignalSpy added(&worker, &WatchWorker::resultAdded);
+    // 注意：正向 --glob 会覆盖忽略文件（rg 自身的行为），这里只用排除规则
+    worker.start(rgExe, dir.path(), "ERROR", true, QStringList() << "--glob=!debug.log");
+
+    // 被 ! glob 排除和被忽略文件忽略的文件，变化后也不能成为结果
+    writeFile(dir.filePath("debug.log"), "ERROR\n", QIODevice::WriteOnly | QIODevice::Append);
+    writeFile(dir.filePath("ignored.log"), "ERROR\n", QIODevice::WriteOnly | QIODevice::Append);
+    writeFile(dir.filePath("app.log"), "ERROR\n", QIODevice::WriteOnly | QIODevice::Append);
+
+    QVERIFY(added.wait(5000));
+    QTest::qWait(1000);   // 等待可能分批到达的其他通知
+    QCOMPARE(added.count(), 1);
+    QCOMPARE(added.first().at(0).toString(), QString("app.log"));
+    worker.stop();
+}
+
+void TestWatchWorker::rgFailureKeepsRows()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString logPath = dir.filePath("app.log");
+    writeFile(logPath, "ERROR disk full\n", QIODevice::WriteOnly);
+
+    // rg 无法运行时结果未知，不能把现有的行当作不再匹配而删除
+    WatchWorker worker;
+    QSignalSpy added(&worker, &WatchWorker::resultAdded);
+    QSignalSpy removed(&worker, &WatchWorker::resultRemoved);
+    worker.start(dir.filePath("missing-rg"), dir.path(), "ERROR", true, QStringList() << "--glob=*.log");
+
+    writeFile(logPath, "all good\n", QIODevice::WriteOnly | QIODevice::Truncate);
+    QVERIFY(!removed.wait(2000));
+    QCOMPARE(added.count(), 0);
+    worker.stop();
+}
+
+QTEST_GUILESS_MAIN(TestWatchWorker)
+#include "tst_watchworker.moc"
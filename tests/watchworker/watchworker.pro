@@ -0,0 +1,18 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_watchworker
+TEMPLATE = app
+DESTDIR = $$OUT_PWD/../bin
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_watchworker.cpp \
+    ../../watchworker.cpp
+
+HEADERS += \
+    ../../watchworker.h
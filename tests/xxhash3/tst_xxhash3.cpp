@@ -0,0 +1,96 @@
+#include "xxhash3.h"
+#include <QtTest>
+#include <QByteArray>
+
+// 期望值由官方 xxHash 0.8 的 XXH3_64bits() 计算，输入与 xxhsum 自检使用的伪随机缓冲区相同
+class TestXxHash3 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void hash_data();
+    void hash();
+    void unaligned();
+
+private:
+    static QByteArray sanityBuffer(int size);
+};
+
+QByteArray TestXxHash3::sanityBuffer(int size)
+{
+    QByteArray buffer(size, Qt::Uninitialized);
+    quint64 generator = 2654435761U;
+    for (int i = 0; i < size; ++i) {
+        buffer[i] = char(generator >> 56);
+        generator *= 11400714785074694797ULL;
+    }
+    return buffer;
+}
+
+void TestXxHash3::hash_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<quint64>("expected");
+
+    // 0 字节
+    QTest::newRow("0") << 0 << Q_UINT64_C(0x2D06800538D394C2);
+    // 1-3 字节
+    QTest::newRow("1") << 1 << Q_UINT64_C(0xC44BDFF4074EECDB);
+    QTest::newRow("2") << 2 << Q_UINT64_C(0x7A9978044CB8A8BB);
+    QTest::newRow("3") << 3 << Q_UINT64_C(0x54247382A8D6B94D);
+    // 4-8 字节
+    QTest::newRow("4") << 4 << Q_UINT64_C(0xE5DC74BC51848A51);
+    QTest::newRow("5") << 5 << Q_UINT64_C(0xE4243F00720306BB);
+    QTest::newRow("8") << 8 << Q_UINT64_C(0x24CCC9ACAA9F65E4);
+    // 9-16 字节
+    QTest::newRow("9") << 9 << Q_UINT64_C(0x14D5001C15DD3F2B);
+    QTest::newRow("12") << 12 << Q_UINT64_C(0xA713DAF0DFBB77E7);
+    QTest::newRow("16") << 16 << Q_UINT64_C(0x981B17D36C7498C9);
+    // 17-128 字节
+    QTest::newRow("17") << 17 << Q_UINT64_C(0x796F5ACD3A60F862);
+    QTest::newRow("31") << 31 << Q_UINT64_C(0x5D516692CA764C50);
+    QTest::newRow("64") << 64 << Q_UINT64_C(0x9CB48487720EC49D);
+    QTest::newRow("100") << 100 << Q_UINT64_C(0x93CD95432B7D483F);
+    QTest::newRow("128") << 128 << Q_UINT64_C(0xFCFF24126754D861);
+    // 129-240 字节
+    QTest::newRow("129") << 129 << Q_UINT64_C(0x98F1B0A679A2CA29);
+    QTest::newRow("200") << 200 << Q_UINT64_C(0xBDDCA58935D7C038);
+    QTest::newRow("240") << 240 << Q_UINT64_C(0x81C3C2B67F568CCF);
+    // >240 字节，单个块内多个 64 字节条带，含末尾不足一个条带的情况
+    QTest::newRow("241") << 241 << Q_UINT64_C(0xC5A639ECD2030E5E);
+    QTest::newRow("255") << 255 << Q_UINT64_C(0xE98F979F4ED8A197);
+    QTest::newRow("512") << 512 << Q_UINT64_C(0x617E49599013CB6B);
+    QTest::newRow("1023") << 1023 << Q_UINT64_C(0x87A8F7B2F2E22496);
+    // 默认 secret 下每块 16 个条带（1024 字节），以下覆盖块边界和多块
+    QTest::newRow("1024") << 1024 << Q_UINT64_C(0xDD85C9B5C1109C5C);
+    QTest::newRow("1025") << 1025 << Q_UINT64_C(0xD870C0FA13211C6A);
+    QTest::newRow("2048") << 2048 << Q_UINT64_C(0xDD59E2C3A5F038E0);
+    QTest::newRow("2367") << 2367 << Q_UINT64_C(0xCB37AEB9E5D361ED);
+    QTest::newRow("3000") << 3000 << Q_UINT64_C(0x120A15F4CBD5A736);
+    QTest::newRow("4096") << 4096 << Q_UINT64_C(0xE91206429D1F48F9);
+    QTest::newRow("4224") << 4224 << Q_UINT64_C(0xA999187671AA8012);
+}
+
+void TestXxHash3::hash()
+{
+    QFETCH(int, size);
+    QFETCH(quint64, expected);
+
+    const QByteArray buffer = sanityBuffer(size);
+    QCOMPARE(xxHash3(buffer.constData(), size_t(buffer.size())), expected);
+}
+
+void TestXxHash3::unaligned()
+{
+    // 内存映射读取时数据起点不一定对齐，结果不能依赖地址
+    const QByteArray buffer = sanityBuffer(4224);
+    for (int offset = 1; offset < 8; ++offset) {
+        QByteArray shifted(offset, '\0');
+        shifted += buffer;
+        QCOMPARE(xxHash3(shifted.constData() + offset, size_t(buffer.size())),
+                 xxHash3(buffer.constData(), size_t(buffer.size())));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestXxHash3)
+#include "tst_xxhash3.moc"
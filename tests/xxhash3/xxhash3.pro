@@ -0,0 +1,18 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_xxhash3
+TEMPLATE = app
+DESTDIR = $$OUT_PWD/../bin
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_xxhash3.cpp \
+    ../../xxhash3.cpp
+
+HEADERS += \
+    ../../xxhash3.h
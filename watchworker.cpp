@@ -0,0 +1,438 @@
+#include "watchworker.h"
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+static const int kDebounceMs = 300;
+static const int kBatchSize = 200;   // 单次 rg.exe 调用传入的文件数，避免命令行过长
+static const int kMatchTimeoutMs = 30000;
+static const int kListTimeoutMs = 120000;
+static const int kRetryDelayMs = 5000;
+static const int kMaxRetries = 5;
+
+WatchWorker::WatchWorker(QObject *parent) : QObject(parent)
+{
+}
+
+void WatchWorker::start(const QString &rgExePath, const QString &rootPath, const QString &searchText,
+                        bool fixedString, const QStringList &globArguments)
+{
+    stop();
+    stopping = false;
+    rgExe = rgExePath;
+    root = QDir(rootPath).absolutePath();
+    text = searchText;
+    fixed = fixedString;
+    globs = globArguments;
+    for (const QString &argument : globArguments) {
+        QString pattern = argument.mid(argument.indexOf('=') + 1).trimmed();
+        bool exclude = pattern.startsWith('!');
+        if (exclude) {
+            pattern = pattern.mid(1);
+        }
+        if (pattern.isEmpty()) {
+            continue;
+        }
+        QRegularExpression re(QRegularExpression::wildcardToRegularExpression(pattern));
+        (exclude ? excludePatterns : includePatterns) << re;
+    }
+
+    watcher = new QFileSystemWatcher(this);
+    debounceTimer = new QTimer(this);
+    debounceTimer->setSingleShot(true);
+    debounceTimer->setInterval(kDebounceMs);
+    connect(watcher, &QFileSystemWatcher::directoryChanged, this, &WatchWorker::onDirectoryChanged);
+    connect(watcher, &QFileSystemWatcher::fileChanged, this, &WatchWorker::onFileChanged);
+    connect(debounceTimer, &QTimer::timeout, this, &WatchWorker::processPending);
+    retryTimer = new QTimer(this);
+    retryTimer->setSingleShot(true);
+    retryTimer->setInterval(kRetryDelayMs);
+    connect(retryTimer, &QTimer::timeout, this, &WatchWorker::processPending);
+
+    addDirectoryTree(root, nullptr);
+    emit watchStarted(snapshots.size());
+}
+
+void WatchWorker::requestStop()
+{
+    stopping = true;
+}
+
+void WatchWorker::stop()
+{
+    delete watcher;
+    watcher = nullptr;
+    delete debounceTimer;
+    debounceTimer = nullptr;
+    delete retryTimer;
+    retryTimer = nullptr;
+    retryCounts.clear();
+    globs.clear();
+    includePatterns.clear();
+    excludePatterns.clear();
+    snapshots.clear();
+    childDirs.clear();
+    pendingDirs.clear();
+}
+
+void WatchWorker::onDirectoryChanged(const QString &dir)
+{
+    // 同一批改动往往触发多次通知，合并后统一处理
+    pendingDirs.insert(dir);
+    debounceTimer->start();
+}
+
+void WatchWorker::onFileChanged(const QString &file)
+{
+    // 目录通知只覆盖新建/删除/改名，原地追加或改写文件要靠文件级通知，
+    // 交给所在目录重新比对大小和修改时间
+    pendingDirs.insert(QFileInfo(file).absolutePath());
+    debounceTimer->start();
+}
+
+void WatchWorker::watchFiles(const QString &dir, const QStringList &names)
+{
+    // 文件列表模式的结果与文件内容无关，不需要逐个文件订阅
+    if (text.isEmpty() || names.isEmpty()) {
+        return;
+    }
+    QStringList files;
+    for (const QString &name : names) {
+        files << dir + "/" + name;
+    }
+    // 先移除再添加：被整体替换（写临时文件再改名）的文件，旧的订阅已随旧文件失效
+    watcher->removePaths(files);
+    watcher->addPaths(files);
+}
+
+bool WatchWorker::matchesPattern(const QString &filePath) const
+{
+    // 快照阶段的粗筛，最终是否属于结果集由 eligibleFiles() 交给 rg 判断
+    QString name = QFileInfo(filePath).fileName();
+    QString relative = QDir(root).relativeFilePath(filePath);
+    for (const QRegularExpression &re : excludePatterns) {
+        if (re.match(name).hasMatch() || re.match(relative).hasMatch()) {
+            return false;
+        }
+    }
+    if (includePatterns.isEmpty()) {
+        return true;
+    }
+    for (const QRegularExpression &re : includePatterns) {
+        if (re.match(name).hasMatch() || re.match(relative).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int WatchWorker::runRg(const QStringList &arguments, int timeoutMs, const std::function<void(const QString &)> &onLine,
+                       QByteArray *errors) const
+{
+    QProcess process;
+    process.start(rgExe, arguments);
+    if (!process.waitForStarted(5000)) {
+        return -1;
+    }
+    QByteArray pending;
+    auto consume = [&]() {
+        pending.append(process.readAllStandardOutput());
+        int newline;
+        while ((newline = pending.indexOf('\n')) >= 0) {
+            QString line = QString::fromUtf8(pending.constData(), newline).trimmed();
+            pending.remove(0, newline + 1);
+            if (!line.isEmpty()) {
+                onLine(line);
+            }
+        }
+    };
+    // 边读边处理，rg --files 的输出可能很大
+    QElapsedTimer timer;
+    timer.start();
+    while (process.state() != QProcess::NotRunning) {
+        if (stopping || timer.elapsed() > timeoutMs) {
+            process.kill();
+            process.waitForFinished();
+            return -1;
+        }
+        process.waitForReadyRead(100);
+        consume();
+    }
+    pending.append('\n');
+    consume();
+    if (errors) {
+        *errors = process.readAllStandardError();
+    }
+    return process.exitStatus() == QProcess::NormalExit ? process.exitCode() : -1;
+}
+
+QSet<QString> WatchWorker::eligibleFiles(const QStringList &files, bool *ok) const
+{
+    // 直接把文件路径交给 rg 会绕过 .gitignore/.ignore/.rgignore，
+    // 因此按首次搜索的规则对根目录列出文件，再与变化的文件取交集
+    QSet<QString> wanted;
+    for (const QString &file : files) {
+        wanted.insert(QFileInfo(file).absoluteFilePath());
+    }
+    QSet<QString> eligible;
+    QStringList arguments;
+    arguments << "--files" << "--no-messages" << globs << "--" << root;
+    int exitCode = runRg(arguments, kListTimeoutMs, [&](const QString &line) {
+        QString path = QFileInfo(line).absoluteFilePath();
+        if (wanted.contains(path)) {
+            eligible.insert(path);
+        }
+    });
+    // 退出码 1 表示没有任何文件
+    *ok = (exitCode == 0 || exitCode == 1);
+    return eligible;
+}
+
+WatchWorker::DirSnapshot WatchWorker::scanDirectory(const QString &dir, QStringList *subDirs) const
+{
+    DirSnapshot snapshot;
+    const QFileInfoList entries = QDir(dir).entryInfoList(
+        QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+    for (const QFileInfo &info : entries) {
+        if (info.isDir()) {
+            QString name = info.fileName();
+            if (name == "System Volume Information" || name == "$RECYCLE.BIN") {
+                continue;
+            }
+            subDirs->append(info.absoluteFilePath());
+        } else if (matchesPattern(info.absoluteFilePath())) {
+            FileStamp stamp;
+            stamp.modified = info.lastModified().toMSecsSinceEpoch();
+            stamp.size = info.size();
+            snapshot.insert(info.fileName(), stamp);
+        }
+    }
+    return snapshot;
+}
+
+void WatchWorker::addDirectoryTree(const QString &dir, QStringList *addedFiles)
+{
+    QStringList stack;
+    QStringList watchPaths;
+    stack << dir;
+    while (!stack.isEmpty()) {
+        QString current = stack.takeLast();
+        QStringList subDirs;
+        DirSnapshot snapshot = scanDirectory(current, &subDirs);
+        if (addedFiles) {
+            for (auto it = snapshot.constBegin(); it != snapshot.constEnd(); ++it) {
+                addedFiles->append(current + "/" + it.key());
+            }
+        }
+        snapshots.insert(current, snapshot);
+        childDirs.insert(current, subDirs);
+        watchPaths << current;
+        watchFiles(current, snapshot.keys());
+        stack << subDirs;
+    }
+    watcher->addPaths(watchPaths);
+}
+
+void WatchWorker::removeDirectoryTree(const QString &dir, QStringList *removedFiles)
+{
+    const QStringList children = childDirs.take(dir);
+    for (const QString &child : children) {
+        removeDirectoryTree(child, removedFiles);
+    }
+    const DirSnapshot snapshot = snapshots.take(dir);
+    QStringList files;
+    for (auto it = snapshot.constBegin(); it != snapshot.constEnd(); ++it) {
+        files << dir + "/" + it.key();
+    }
+    removedFiles->append(files);
+    if (!files.isEmpty()) {
+        watcher->removePaths(files);
+    }
+    watcher->removePath(dir);
+}
+
+QSet<QString> WatchWorker::matchContent(const QStringList &files, QSet<QString> *unknown) const
+{
+    QSet<QString> matched;
+    for (int i = 0; i < files.size() && !stopping; i += kBatchSize) {
+        const QStringList batch = files.mid(i, kBatchSize);
+        // 不加 --no-messages：需要从错误输出中找出读取失败的文件
+        QStringList arguments;
+        arguments << "-l";
+        if (fixed) {
+            arguments << "-F";
+        }
+        arguments << "-e" << text << "--";
+        arguments << batch;
+        QByteArray errors;
+        int exitCode = runRg(arguments, kMatchTimeoutMs, [&matched](const QString &line) {
+            matched.insert(QFileInfo(line).absoluteFilePath());
+        }, &errors);
+        if (exitCode == 0 || exitCode == 1) {
+            continue;
+        }
+
+        // 超时或启动失败：整批都无法判断；退出码 2：尽量定位到具体出错的文件
+        QStringList unresolved;
+        for (const QString &file : batch) {
+            if (!matched.contains(QFileInfo(file).absoluteFilePath())) {
+                unresolved << file;
+            }
+        }
+        const QString errorText = QString::fromUtf8(errors);
+        bool attributed = false;
+        if (exitCode == 2) {
+            for (const QString &file : std::as_const(unresolved)) {
+                if (errorText.contains(file) || errorText.contains(QDir::toNativeSeparators(file))) {
+                    unknown->insert(QFileInfo(file).absoluteFilePath());
+                    attributed = true;
+                }
+            }
+        }
+        if (!attributed) {
+            for (const QString &file : std::as_const(unresolved)) {
+                unknown->insert(QFileInfo(file).absoluteFilePath());
+            }
+        }
+    }
+    return matched;
+}
+
+void WatchWorker::scheduleRetry(const QStringList &files, const QSet<QString> &unknown)
+{
+    for (const QString &file : files) {
+        QString path = QFileInfo(file).absoluteFilePath();
+        if (!unknown.contains(path)) {
+            retryCounts.remove(path);
+            continue;
+        }
+        // 长期被锁定的文件不无限重试，保留其原有的结果行
+        int attempts = retryCounts.value(path) + 1;
+        if (attempts > kMaxRetries) {
+            retryCounts.remove(path);
+        } else {
+            retryCounts.insert(path, attempts);
+        }
+    }
+    if (!retryCounts.isEmpty()) {
+        retryTimer->start();
+    }
+}
+
+void WatchWorker::processPending()
+{
+    if (stopping) {
+        return;
+    }
+    const QSet<QString> dirs = pendingDirs;
+    pendingDirs.clear();
+
+    QStringList changedFiles;
+    QStringList removedFiles;
+    for (const QString &dir : dirs) {
+        if (!snapshots.contains(dir)) {
+            continue; // 已随上级目录一起移除
+        }
+        if (!QFileInfo::exists(dir)) {
+            removeDirectoryTree(dir, &removedFiles);
+            continue;
+        }
+
+        QStringList newSubDirs;
+        DirSnapshot newSnapshot = scanDirectory(dir, &newSubDirs);
+        const DirSnapshot &oldSnapshot = snapshots[dir];
+        QStringList changedNames;
+        for (auto it = newSnapshot.constBegin(); it != newSnapshot.constEnd(); ++it) {
+            auto old = oldSnapshot.constFind(it.key());
+            if (old == oldSnapshot.constEnd() || !(old.value() == it.value())) {
+                changedNames << it.key();
+                changedFiles << dir + "/" + it.key();
+            }
+        }
+        QStringList goneFiles;
+        for (auto it = oldSnapshot.constBegin(); it != oldSnapshot.constEnd(); ++it) {
+            if (!newSnapshot.contains(it.key())) {
+                goneFiles << dir + "/" + it.key();
+            }
+        }
+        snapshots.insert(dir, newSnapshot);
+        watchFiles(dir, changedNames);
+        if (!goneFiles.isEmpty()) {
+            watcher->removePaths(goneFiles);
+            removedFiles << goneFiles;
+        }
+
+        const QStringList oldSubDirs = childDirs.value(dir);
+        childDirs.insert(dir, newSubDirs);
+        for (const QString &sub : oldSubDirs) {
+            if (!newSubDirs.contains(sub)) {
+                removeDirectoryTree(sub, &removedFiles);
+            }
+        }
+        for (const QString &sub : newSubDirs) {
+            if (!oldSubDirs.contains(sub)) {
+                addDirectoryTree(sub, &changedFiles);
+            }
+        }
+    }
+
+    for (const QString &file : removedFiles) {
+        QFileInfo info(file);
+        retryCounts.remove(info.absoluteFilePath());
+        emit resultRemoved(info.fileName(), info.absolutePath());
+    }
+
+    // 上次无法判断的文件即使没有新的变化也重新检查
+    QSet<QString> changedSet(changedFiles.constBegin(), changedFiles.constEnd());
+    for (auto it = retryCounts.constBegin(); it != retryCounts.constEnd(); ++it) {
+        if (!changedSet.contains(it.key()) && QFileInfo::exists(it.key())) {
+            changedFiles << it.key();
+            changedSet.insert(it.key());
+        }
+    }
+    if (changedFiles.isEmpty()) {
+        return;
+    }
+
+    // 先按首次搜索的过滤规则（--glob、忽略文件）筛选，不在结果集范围内的文件不应出现
+    QSet<QString> unknown;
+    bool listed = false;
+    const QSet<QString> eligible = eligibleFiles(changedFiles, &listed);
+    QStringList candidates;
+    for (const QString &file : std::as_const(changedFiles)) {
+        QFileInfo info(file);
+        if (!listed) {
+            unknown.insert(info.absoluteFilePath());
+        } else if (eligible.contains(info.absoluteFilePath())) {
+            candidates << file;
+        } else {
+            emit resultRemoved(info.fileName(), info.absolutePath());
+        }
+    }
+
+    // 文件列表模式到此为止；内容搜索只对变化的文件重新跑 rg.exe
+    QSet<QString> matched;
+    bool filesMode = text.isEmpty();
+    if (!filesMode) {
+        matched = matchContent(candidates, &unknown);
+    }
+    if (stopping) {
+        return;
+    }
+    for (const QString &file : std::as_const(candidates)) {
+        QFileInfo info(file);
+        if (unknown.contains(info.absoluteFilePath())) {
+            continue;   // 结果未知，保留现有的行，稍后重试
+        }
+        if (filesMode || matched.contains(info.absoluteFilePath())) {
+            emit resultAdded(info.fileName(), info.absolutePath());
+        } else {
+            emit resultRemoved(info.fileName(), info.absolutePath());
+        }
+    }
+    scheduleRetry(changedFiles, unknown);
+}
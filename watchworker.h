@@ -0,0 +1,79 @@
+#ifndef WATCHWORKER_H
+#define WATCHWORKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QRegularExpression>
+#include <QList>
+#include <functional>
+#include <atomic>
+
+class QFileSystemWatcher;
+class QTimer;
+
+// 监视模式：搜索完成后订阅目录变化（内容搜索时还订阅各文件的改写），只对变化的文件重新匹配
+class WatchWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit WatchWorker(QObject *parent = nullptr);
+
+    // 可从其他线程调用：让正在运行的 rg 立即结束，处理中的批次不再发出结果
+    void requestStop();
+
+public slots:
+    // globArguments 为首次搜索使用的 --glob=... 参数，监视时沿用同一组过滤规则
+    void start(const QString &rgExePath, const QString &rootPath, const QString &searchText,
+               bool fixedString, const QStringList &globArguments);
+    void stop();
+
+signals:
+    void watchStarted(int directoryCount);
+    void resultAdded(const QString &name, const QString &path);
+    void resultRemoved(const QString &name, const QString &path);
+
+private slots:
+    void onDirectoryChanged(const QString &dir);
+    void onFileChanged(const QString &file);
+    void processPending();
+
+private:
+    struct FileStamp {
+        qint64 modified = 0;
+        qint64 size = 0;
+        bool operator==(const FileStamp &other) const { return modified == other.modified && size == other.size; }
+    };
+    using DirSnapshot = QHash<QString, FileStamp>;
+
+    void addDirectoryTree(const QString &dir, QStringList *addedFiles);
+    void removeDirectoryTree(const QString &dir, QStringList *removedFiles);
+    DirSnapshot scanDirectory(const QString &dir, QStringList *subDirs) const;
+    void watchFiles(const QString &dir, const QStringList &names);
+    bool matchesPattern(const QString &filePath) const;
+    int runRg(const QStringList &arguments, int timeoutMs, const std::function<void(const QString &)> &onLine,
+              QByteArray *errors = nullptr) const;
+    QSet<QString> eligibleFiles(const QStringList &files, bool *ok) const;
+    // unknown 收集超时、rg 失败或无法读取（如被其他进程锁定）而无法判断的文件
+    QSet<QString> matchContent(const QStringList &files, QSet<QString> *unknown) const;
+    void scheduleRetry(const QStringList &files, const QSet<QString> &unknown);
+
+    QFileSystemWatcher *watcher = nullptr;
+    QTimer *debounceTimer = nullptr;
+    QTimer *retryTimer = nullptr;
+    QString rgExe;
+    QString root;
+    QString text;
+    bool fixed = true;
+    QStringList globs;
+    QList<QRegularExpression> includePatterns;
+    QList<QRegularExpression> excludePatterns;   // 以 ! 开头的 glob
+    QHash<QString, DirSnapshot> snapshots;   // 目录 -> 其中符合过滤条件的文件
+    QHash<QString, QStringList> childDirs;   // 目录 -> 直接子目录
+    QSet<QString> pendingDirs;
+    QHash<QString, int> retryCounts;          // 待重试的文件 -> 已重试次数
+    std::atomic<bool> stopping{false};
+};
+
+#endif // WATCHWORKER_H
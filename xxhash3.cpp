@@ -0,0 +1,240 @@
+#include "xxhash3.h"
+#include <QtEndian>
+
+// 算法见 https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+
+namespace {
+
+const quint64 kPrime32_1 = 0x9E3779B1U;
+const quint64 kPrime32_2 = 0x85EBCA77U;
+const quint64 kPrime32_3 = 0xC2B2AE3DU;
+const quint64 kPrime64_1 = 0x9E3779B185EBCA87ULL;
+const quint64 kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+const quint64 kPrime64_3 = 0x165667B19E3779F9ULL;
+const quint64 kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+const quint64 kPrime64_5 = 0x27D4EB2F165667C5ULL;
+const quint64 kPrimeMx1 = 0x165667919E3779F9ULL;
+const quint64 kPrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+const size_t kSecretSize = 192;
+const size_t kStripeLen = 64;
+const size_t kSecretConsumeRate = 8;
+const size_t kAccCount = 8;
+const size_t kMidSizeMax = 240;
+
+const uchar kSecret[kSecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline quint64 read64(const uchar *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+inline quint32 read32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+inline quint64 rotl64(quint64 x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+// 64x64 -> 128 位乘法，返回高低两半异或
+inline quint64 mul128Fold64(quint64 a, quint64 b)
+{
+    const quint64 loLo = (a & 0xFFFFFFFFULL) * (b & 0xFFFFFFFFULL);
+    const quint64 hiLo = (a >> 32) * (b & 0xFFFFFFFFULL);
+    const quint64 loHi = (a & 0xFFFFFFFFULL) * (b >> 32);
+    const quint64 hiHi = (a >> 32) * (b >> 32);
+    const quint64 cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFULL) + loHi;
+    const quint64 upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+    const quint64 lower = (cross << 32) | (loLo & 0xFFFFFFFFULL);
+    return lower ^ upper;
+}
+
+inline quint64 xxh64Avalanche(quint64 h)
+{
+    h ^= h >> 33;
+    h *= kPrime64_2;
+    h ^= h >> 29;
+    h *= kPrime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline quint64 avalanche(quint64 h)
+{
+    h ^= h >> 37;
+    h *= kPrimeMx1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline quint64 rrmxmx(quint64 h, quint64 len)
+{
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= kPrimeMx2;
+    h ^= (h >> 35) + len;
+    h *= kPrimeMx2;
+    h ^= h >> 28;
+    return h;
+}
+
+inline quint64 mix16B(const uchar *input, const uchar *secret)
+{
+    return mul128Fold64(read64(input) ^ read64(secret), read64(input + 8) ^ read64(secret + 8));
+}
+
+quint64 len0To16(const uchar *input, size_t len)
+{
+    if (len > 8) {
+        const quint64 bitflip1 = read64(kSecret + 24) ^ read64(kSecret + 32);
+        const quint64 bitflip2 = read64(kSecret + 40) ^ read64(kSecret + 48);
+        const quint64 lo = read64(input) ^ bitflip1;
+        const quint64 hi = read64(input + len - 8) ^ bitflip2;
+        const quint64 acc = len + qbswap(lo) + hi + mul128Fold64(lo, hi);
+        return avalanche(acc);
+    }
+    if (len >= 4) {
+        const quint64 input1 = read32(input);
+        const quint64 input2 = read32(input + len - 4);
+        const quint64 bitflip = read64(kSecret + 8) ^ read64(kSecret + 16);
+        const quint64 keyed = (input2 + (input1 << 32)) ^ bitflip;
+        return rrmxmx(keyed, len);
+    }
+    if (len > 0) {
+        const quint32 c1 = input[0];
+        const quint32 c2 = input[len >> 1];
+        const quint32 c3 = input[len - 1];
+        const quint32 combined = (c1 << 16) | (c2 << 24) | c3 | (quint32(len) << 8);
+        const quint64 bitflip = quint64(read32(kSecret) ^ read32(kSecret + 4));
+        return xxh64Avalanche(quint64(combined) ^ bitflip);
+    }
+    return xxh64Avalanche(read64(kSecret + 56) ^ read64(kSecret + 64));
+}
+
+quint64 len17To128(const uchar *input, size_t len)
+{
+    quint64 acc = len * kPrime64_1;
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16B(input + 48, kSecret + 96);
+                acc += mix16B(input + len - 64, kSecret + 112);
+            }
+            acc += mix16B(input + 32, kSecret + 64);
+            acc += mix16B(input + len - 48, kSecret + 80);
+        }
+        acc += mix16B(input + 16, kSecret + 32);
+        acc += mix16B(input + len - 32, kSecret + 48);
+    }
+    acc += mix16B(input, kSecret);
+    acc += mix16B(input + len - 16, kSecret + 16);
+    return avalanche(acc);
+}
+
+quint64 len129To240(const uchar *input, size_t len)
+{
+    const size_t startOffset = 3;
+    const size_t lastOffset = 17;
+    const size_t secretSizeMin = 136;
+    const size_t rounds = len / 16;
+
+    quint64 acc = len * kPrime64_1;
+    for (size_t i = 0; i < 8; ++i) {
+        acc += mix16B(input + 16 * i, kSecret + 16 * i);
+    }
+    quint64 accEnd = mix16B(input + len - 16, kSecret + secretSizeMin - lastOffset);
+    acc = avalanche(acc);
+    for (size_t i = 8; i < rounds; ++i) {
+        accEnd += mix16B(input + 16 * i, kSecret + 16 * (i - 8) + startOffset);
+    }
+    return avalanche(acc + accEnd);
+}
+
+inline void accumulate512(quint64 *acc, const uchar *input, const uchar *secret)
+{
+    for (size_t i = 0; i < kAccCount; ++i) {
+        const quint64 value = read64(input + 8 * i);
+        const quint64 key = value ^ read64(secret + 8 * i);
+        acc[i ^ 1] += value;
+        acc[i] += (key & 0xFFFFFFFFULL) * (key >> 32);
+    }
+}
+
+inline void scramble(quint64 *acc, const uchar *secret)
+{
+    for (size_t i = 0; i < kAccCount; ++i) {
+        quint64 a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(secret + 8 * i);
+        a *= kPrime32_1;
+        acc[i] = a;
+    }
+}
+
+quint64 hashLong(const uchar *input, size_t len)
+{
+    const size_t lastAccStart = 7;
+    const size_t mergeAccsStart = 11;
+    const size_t stripesPerBlock = (kSecretSize - kStripeLen) / kSecretConsumeRate;
+    const size_t blockLen = kStripeLen * stripesPerBlock;
+    const size_t blocks = (len - 1) / blockLen;
+
+    quint64 acc[kAccCount] = {
+        kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+        kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1
+    };
+
+    for (size_t n = 0; n < blocks; ++n) {
+        const uchar *block = input + n * blockLen;
+        for (size_t s = 0; s < stripesPerBlock; ++s) {
+            accumulate512(acc, block + s * kStripeLen, kSecret + s * kSecretConsumeRate);
+        }
+        scramble(acc, kSecret + kSecretSize - kStripeLen);
+    }
+
+    const size_t stripes = ((len - 1) - blockLen * blocks) / kStripeLen;
+    const uchar *tail = input + blocks * blockLen;
+    for (size_t s = 0; s < stripes; ++s) {
+        accumulate512(acc, tail + s * kStripeLen, kSecret + s * kSecretConsumeRate);
+    }
+    accumulate512(acc, input + len - kStripeLen, kSecret + kSecretSize - kStripeLen - lastAccStart);
+
+    quint64 result = len * kPrime64_1;
+    for (size_t i = 0; i < 4; ++i) {
+        result += mul128Fold64(acc[2 * i] ^ read64(kSecret + mergeAccsStart + 16 * i),
+                               acc[2 * i + 1] ^ read64(kSecret + mergeAccsStart + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+} // namespace
+
+quint64 xxHash3(const void *data, size_t size)
+{
+    const uchar *input = static_cast<const uchar *>(data);
+    if (size <= 16) {
+        return len0To16(input, size);
+    }
+    if (size <= 128) {
+        return len17To128(input, size);
+    }
+    if (size <= kMidSizeMax) {
+        return len129To240(input, size);
+    }
+    return hashLong(input, size);
+}
@@ -0,0 +1,9 @@
+#ifndef XXHASH3_H
+#define XXHASH3_H
+
+#include <QtGlobal>
+
+// XXH3 64 位哈希（seed = 0，默认 secret），标量实现，结果与官方 XXH3_64bits() 一致
+quint64 xxHash3(const void *data, size_t size);
+
+#endif // XXHASH3_H